@@ -23,8 +23,40 @@ BEGIN_RCPP
 END_RCPP
 }
 
+// canny_edge_detector_batch
+List canny_edge_detector_batch(SEXP image, int X, int Y, int frames, double s, double low_thr, double high_thr, bool accGrad, int threads);
+RcppExport SEXP _image_CannyEdges_canny_edge_detector_batch(SEXP imageSEXP, SEXP XSEXP, SEXP YSEXP, SEXP framesSEXP, SEXP sSEXP, SEXP low_thrSEXP, SEXP high_thrSEXP, SEXP accGradSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type image(imageSEXP);
+    Rcpp::traits::input_parameter< int >::type X(XSEXP);
+    Rcpp::traits::input_parameter< int >::type Y(YSEXP);
+    Rcpp::traits::input_parameter< int >::type frames(framesSEXP);
+    Rcpp::traits::input_parameter< double >::type s(sSEXP);
+    Rcpp::traits::input_parameter< double >::type low_thr(low_thrSEXP);
+    Rcpp::traits::input_parameter< double >::type high_thr(high_thrSEXP);
+    Rcpp::traits::input_parameter< bool >::type accGrad(accGradSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(canny_edge_detector_batch(image, X, Y, frames, s, low_thr, high_thr, accGrad, threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// canny_fftw_wisdom
+void canny_fftw_wisdom(std::string file);
+RcppExport SEXP _image_CannyEdges_canny_fftw_wisdom(SEXP fileSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< std::string >::type file(fileSEXP);
+    canny_fftw_wisdom(file);
+    return R_NilValue;
+END_RCPP
+}
+
 static const R_CallMethodDef CallEntries[] = {
     {"_image_CannyEdges_canny_edge_detector", (DL_FUNC) &_image_CannyEdges_canny_edge_detector, 7},
+    {"_image_CannyEdges_canny_edge_detector_batch", (DL_FUNC) &_image_CannyEdges_canny_edge_detector_batch, 9},
+    {"_image_CannyEdges_canny_fftw_wisdom", (DL_FUNC) &_image_CannyEdges_canny_fftw_wisdom, 1},
     {NULL, NULL, 0}
 };
 
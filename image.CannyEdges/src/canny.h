@@ -7,8 +7,6 @@
 #include <complex.h>
 #include <fftw3.h>
 
-#include "adsf.h"
-
 #ifndef M_PI
 #define M_PI		3.14159265358979323846	/* pi */
 #endif
@@ -16,3 +14,5 @@
 void error(const char *fmt, ...);
 void *xmalloc(size_t size);
 void gblur(double *y, double *x, int w, int h, int pd, double s);
+void gblur_prepare(int w, int h, double s);
+void set_wisdom_file(const char *filename);
@@ -9,9 +9,13 @@ extern "C" {
 #include <limits.h>
 #include <math.h>
 
-#include "adsf.h"
+#include <stdint.h>
+
 #include "canny.h"
 }
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // Mirroring
 int mirror(int x, int y, size_t nx, size_t ny) {
@@ -61,50 +65,271 @@ int value(int x, int y, size_t nx, size_t ny) {
   //return mirror(x,y,nx,ny)
 }
 
-// Specific bilinear interpolation
-double bilin(double* grad, double t, size_t x, size_t y, size_t nx, size_t ny, int dir) {
-  double x1,x2,xt,y1,y2,yt;
-
-  // Here are the points where we would like to evaluate grad
-  xt = dir * cos(t);
-  yt = dir * sin(t);
-  // and the points where we are able to evaluate grad
-  x1 = floor(xt), x2 = x1 + 1;
-  y1 = floor(yt), y2 = y1 + 1;
-
-  //Interpolation in the x direction
-  // y = y1 :
-  double gradx1 = (x2 - xt) * grad[value(x + x1, y + y1, nx, ny)]
-  + (xt - x1) * grad[value(x + x2, y + y1, nx, ny)];
-  // y = y2 :
-  double gradx2 = (x2 - xt) * grad[value(x + x1, y + y2, nx, ny)]
-  + (xt - x1) * grad[value(x + x2, y + y2, nx, ny)];
-  // Interpolation in the y direction
-  double gradxy = (y2 - yt) * gradx1 + (yt - y1) * gradx2;
-  return gradxy;
-}
-
-//Computation of the maxima of the gradient
-static void maxima(double* grad, double *theta, unsigned char *output, size_t nx, size_t ny, int low_thr,int high_thr) {
-  for(size_t x = 0 ; x < nx ; x++) {
-    for(size_t y = 0 ; y < ny ; y++) {
-      double t = theta[y*nx + x];
-
-      double prev = bilin(grad,t,x,y,nx,ny,-1);
-      double next = bilin(grad,t,x,y,nx,ny,1);
-      double now = grad[y*nx+x];
-
-      if ((now <= prev) || (now <= next) || (now <= low_thr))
-        // If it is not a local maximum or is below the low threshold, discard
-        output[y*nx + x] = 0;
-      else if (now >= high_thr)
-        output[y*nx + x] = 2;
-      else
-        output[y*nx + x] = 1;
+// Rows of the gradient handled by one thread at a time
+#define BAND_ROWS 64
+
+// Gradient of row y of the padded image (one replicated pixel on each side):
+// magnitude with one replicated pixel on each side, horizontal and vertical part
+static void gradient_row(const float *pad, int pw, int nx, int y, bool accGrad,
+                         float *mag, float *gx, float *gy) {
+  const float *up = pad + (size_t)y*pw + 1;
+  const float *mid = up + pw;
+  const float *down = mid + pw;
+  if(accGrad) {
+    for(int x = 0; x < nx; x++) {
+      gx[x] = 2*(mid[x+1] - mid[x-1]) + down[x+1] - down[x-1] + up[x+1] - up[x-1];
+      gy[x] = 2*(down[x] - up[x]) + down[x+1] - up[x+1] + down[x-1] - up[x-1];
+    }
+  }
+  else {
+    for(int x = 0; x < nx; x++) {
+      gx[x] = mid[x+1] - mid[x-1];
+      gy[x] = down[x] - up[x];
+    }
+  }
+  for(int x = 0; x < nx; x++)
+    mag[x] = sqrtf(gx[x]*gx[x] + gy[x]*gy[x]);
+  mag[-1] = mag[0];
+  mag[nx] = mag[nx-1];
+}
+
+// Buffers of the detector for images of nx x ny pixels, allocated once and reused for
+// every image of that size. threads is the number of threads working on one image.
+typedef struct {
+  int nx, ny, threads;
+  double *in, *data;      // image and blurred image
+  float *pad;             // blurred image with one replicated pixel around it
+  float *work;            // per thread: 3 rows of gradient magnitude and components
+  unsigned char *output;  // classes of the pixels, then the edges
+  uint32_t *label;        // labels of the hysteresis
+} canny_workspace;
+
+static size_t ring_size(int nx) {
+  return 3 * (size_t)(nx + 2 + 2*nx);
+}
+
+static canny_workspace *make_canny_workspace(int nx, int ny, int threads) {
+  // the labels of the hysteresis keep a flag in the highest bit of the pixel index
+  if((size_t)nx*ny >= 0x80000000u)
+    error("canny: image too large");
+  canny_workspace *w = (canny_workspace *) xmalloc(sizeof(canny_workspace));
+  size_t n = (size_t)nx*ny;
+  w->nx = nx;
+  w->ny = ny;
+  w->threads = threads < 1 ? 1 : threads;
+  w->in = (double *) xmalloc(sizeof(double) * n);
+  w->data = (double *) xmalloc(sizeof(double) * n);
+  w->pad = (float *) xmalloc(sizeof(float) * (nx + 2) * (ny + 2));
+  w->work = (float *) xmalloc(sizeof(float) * ring_size(nx) * w->threads);
+  w->output = (unsigned char *) xmalloc(n);
+  w->label = (uint32_t *) xmalloc(sizeof(uint32_t) * n);
+  return w;
+}
+
+static void free_canny_workspace(canny_workspace *w) {
+  free(w->in);
+  free(w->data);
+  free(w->pad);
+  free(w->work);
+  free(w->output);
+  free(w->label);
+  free(w);
+}
+
+// Bilinear interpolation of the gradient magnitude at (x + xt, y + yt) with |xt|, |yt| <= 1,
+// given the rows y-1, y and y+1 of the magnitude
+static inline float interpolate(float *const rows[3], int x, float xt, float yt) {
+  float x1 = floorf(xt), y1 = floorf(yt);
+  // at xt = 1 (yt = 1) only the sample at x + 1 (y + 1) has a non-zero weight
+  if(x1 > 0) x1 = 0;
+  if(y1 > 0) y1 = 0;
+  float fx = xt - x1, fy = yt - y1;
+  const float *r1 = rows[(int)y1 + 1] + x + (int)x1;
+  const float *r2 = rows[(int)y1 + 2] + x + (int)x1;
+  return (1 - fy) * ((1 - fx)*r1[0] + fx*r1[1]) + fy * ((1 - fx)*r2[0] + fx*r2[1]);
+}
+
+// Gradient and suppression of non-maxima in one pass over the rows of the blurred image.
+// The image is copied into a float buffer with one replicated pixel around it such that
+// no neighbour read needs a bounds check. The rows are split in bands over the threads and
+// every thread only keeps the gradient of the row it suppresses and of the rows above and below.
+// The output is 0 for no edge, 1 for a weak and 2 for a strong edge pixel.
+static void gradient_maxima(canny_workspace *w, bool accGrad, int low_thr, int high_thr) {
+  const double *data = w->data;
+  unsigned char *output = w->output;
+  float *pad = w->pad, *work = w->work;
+  int nx = w->nx, ny = w->ny, pw = nx + 2;
+  for(int y = -1; y <= ny; y++) {
+    const double *src = data + (size_t)(y < 0 ? 0 : (y < ny ? y : ny - 1)) * nx;
+    float *dst = pad + (size_t)(y + 1)*pw + 1;
+    for(int x = 0; x < nx; x++)
+      dst[x] = (float)src[x];
+    dst[-1] = dst[0];
+    dst[nx] = dst[nx - 1];
+  }
+
+  // per thread: 3 rows of magnitude (padded), horizontal and vertical gradient
+  size_t ring = ring_size(nx);
+  int bands = (ny + BAND_ROWS - 1) / BAND_ROWS;
+
+  #pragma omp parallel for schedule(dynamic) num_threads(w->threads) if(w->threads > 1)
+  for(int band = 0; band < bands; band++) {
+    int t = 0;
+#ifdef _OPENMP
+    t = omp_get_thread_num();
+#endif
+    float *mag[3], *gx[3], *gy[3];
+    for(int i = 0; i < 3; i++) {
+      mag[i] = work + ring*t + (size_t)i*(pw + 2*nx) + 1;
+      gx[i] = mag[i] + pw - 1;
+      gy[i] = gx[i] + nx;
+    }
+    int y0 = band * BAND_ROWS, y1 = y0 + BAND_ROWS < ny ? y0 + BAND_ROWS : ny;
+    // rows outside the image take the gradient of the border row
+    gradient_row(pad, pw, nx, y0 > 0 ? y0 - 1 : 0, accGrad, mag[0], gx[0], gy[0]);
+    gradient_row(pad, pw, nx, y0, accGrad, mag[1], gx[1], gy[1]);
+    for(int y = y0; y < y1; y++) {
+      gradient_row(pad, pw, nx, y + 1 < ny ? y + 1 : ny - 1, accGrad, mag[2], gx[2], gy[2]);
+      unsigned char *out = output + (size_t)y*nx;
+      for(int x = 0; x < nx; x++) {
+        float now = mag[1][x];
+        // direction of the gradient, (1, 0) when it vanishes as atan2(0, 0) = 0
+        float c = now > 0 ? gx[1][x] / now : 1;
+        float s = now > 0 ? gy[1][x] / now : 0;
+        float prev = interpolate(mag, x, -c, -s);
+        float next = interpolate(mag, x, c, s);
+        if ((now <= prev) || (now <= next) || (now <= low_thr))
+          // If it is not a local maximum or is below the low threshold, discard
+          out[x] = 0;
+        else if (now >= high_thr)
+          out[x] = 2;
+        else
+          out[x] = 1;
+      }
+      // rotate the rows: y becomes y - 1 and y + 1 becomes y
+      float *tmp = mag[0]; mag[0] = mag[1]; mag[1] = mag[2]; mag[2] = tmp;
+      tmp = gx[0]; gx[0] = gx[1]; gx[1] = gx[2]; gx[2] = tmp;
+      tmp = gy[0]; gy[0] = gy[1]; gy[1] = gy[2]; gy[2] = tmp;
     }
   }
 }
 
+// Labels of the hysteresis are pixel indices: every marked pixel points to a pixel
+// of its connected edge with a smaller index, the root points to itself and carries
+// the STRONG bit when the edge contains a strong pixel
+#define STRONG 0x80000000u
+#define LABEL(l) ((l) & ~STRONG)
+
+static inline uint32_t find_root(const uint32_t *label, uint32_t a) {
+  while(LABEL(label[a]) != a)
+    a = LABEL(label[a]);
+  return a;
+}
+
+// find with path compression, only used where the caller owns the whole path
+static inline uint32_t compress_root(uint32_t *label, uint32_t a) {
+  uint32_t r = find_root(label, a);
+  while(a != r) {
+    uint32_t next = LABEL(label[a]);
+    label[a] = r;
+    a = next;
+  }
+  return r;
+}
+
+static inline void unite(uint32_t *label, uint32_t a, uint32_t b) {
+  a = compress_root(label, a);
+  b = compress_root(label, b);
+  if(a == b) return;
+  uint32_t strong = (label[a] | label[b]) & STRONG;
+  if(a < b) {
+    label[b] = a;
+    label[a] = a | strong;
+  }
+  else {
+    label[a] = b;
+    label[b] = b | strong;
+  }
+}
+
+// unites the marked pixel d of row y with its marked 8-neighbours on row y - 1
+static inline void unite_above(const unsigned char *output, uint32_t *label, int nx, int x, uint32_t d) {
+  for(int ex = x > 0 ? -1 : 0; ex <= 1 && x + ex < nx; ex++)
+    if(output[d - nx + ex])
+      unite(label, d, d - nx + ex);
+}
+
+#ifdef CANNY_DEBUG
+static void check_labels(const unsigned char *output, const uint32_t *label, size_t n) {
+  for(size_t d = 0; d < n; d++)
+    if(output[d] && (LABEL(label[d]) > d || !output[LABEL(label[d])]))
+      error("hysteresis: inconsistent labels");
+}
+#endif
+
+// Connected components of the marked pixels (8-connectivity) in two phases: bands of
+// rows are labelled independently in parallel, after which the labels are merged
+// along the borders of the bands. Edges without a strong pixel are removed,
+// the pixels of the other edges are set to 255.
+// The workspace guarantees that nx * ny < STRONG.
+static void hysteresis(canny_workspace *w) {
+  unsigned char *output = w->output;
+  uint32_t *label = w->label;
+  int nx = w->nx, ny = w->ny;
+  int bands = (ny + BAND_ROWS - 1) / BAND_ROWS;
+
+  #pragma omp parallel for schedule(dynamic) num_threads(w->threads) if(w->threads > 1)
+  for(int band = 0; band < bands; band++) {
+    int y0 = band * BAND_ROWS, y1 = y0 + BAND_ROWS < ny ? y0 + BAND_ROWS : ny;
+    for(int y = y0; y < y1; y++) {
+      for(int x = 0; x < nx; x++) {
+        uint32_t d = (uint32_t)y*nx + x;
+        if(!output[d]) continue;
+        label[d] = d | (output[d] == 2 ? STRONG : 0);
+        if(x > 0 && output[d - 1])
+          unite(label, d, d - 1);
+        if(y > y0)
+          unite_above(output, label, nx, x, d);
+      }
+    }
+  }
+  for(int band = 1; band < bands; band++) {
+    uint32_t row = (uint32_t)band * BAND_ROWS * nx;
+    for(int x = 0; x < nx; x++)
+      if(output[row + x])
+        unite_above(output, label, nx, x, row + x);
+  }
+#ifdef CANNY_DEBUG
+  check_labels(output, label, (size_t)nx*ny);
+#endif
+
+  #pragma omp parallel for schedule(dynamic) num_threads(w->threads) if(w->threads > 1)
+  for(int band = 0; band < bands; band++) {
+    size_t d0 = (size_t)band * BAND_ROWS * nx;
+    size_t d1 = (size_t)(band + 1) * BAND_ROWS * nx;
+    if(d1 > (size_t)nx*ny) d1 = (size_t)nx*ny;
+    for(size_t d = d0; d < d1; d++)
+      if(output[d])
+        // Very high value so it can be seen
+        output[d] = (label[find_root(label, d)] & STRONG) ? 255 : 0;
+  }
+}
+
+// Edges of the image in w->in: 255 on an edge, 0 elsewhere in w->output.
+// Returns the number of edge pixels.
+static int canny(canny_workspace *w, double s, double low_thr, double high_thr, bool accGrad) {
+  // Gaussian filtering
+  gblur(w->data, w->in, w->nx, w->ny, 1, s);
+  // Gradient and suppression of non-maxima
+  gradient_maxima(w, accGrad, low_thr, high_thr);
+  // Hysteresis: keep the connected edges which contain a strong pixel
+  hysteresis(w);
+  int nonzero = 0;
+  for(size_t d = 0; d < (size_t)w->nx*w->ny; d++)
+    nonzero += w->output[d] == 255;
+  return nonzero;
+}
+
 // static const char *help =
 //   "canny usage:\n"
 //   "\t-h | --help          Display this help message\n"
@@ -132,107 +357,20 @@ List canny_edge_detector(IntegerVector image, int X, int Y,
   //double low_thr=3, high_thr = 10;		// Thresholds
   //bool accGrad = false;
 
-  //unsigned char input[image.size()];
-  unsigned char *input = new unsigned char[image.size()];
-  for(int i = 0; i < image.size(); i++) input[i] = (unsigned char)image[i];
-
-  double* in = (double *) xmalloc(sizeof(double) * nx * ny);
-
+  int threads = 1;
+#ifdef _OPENMP
+  threads = omp_get_max_threads();
+#endif
+  canny_workspace *w = make_canny_workspace(nx, ny, threads);
   for(size_t d = 0 ; d < nx*ny ; d++)
-    in[d] = (double) input[d];
-  double* data = (double *) xmalloc(sizeof(double) * nx * ny);
-
-  // Gaussian filtering
-  gblur(data, in, nx, ny, 1, s);
-  free(in);
-  double* grad = (double *) xmalloc(sizeof(double) * nx * ny);
-  double* theta = (double *) xmalloc(sizeof(double) * nx * ny);
-  double hgrad,vgrad;
-
-  // Gradient value :
-  for(size_t x = 0 ; x < nx ; x++) {
-    for(size_t y = 0 ; y < ny ; y++) {
-      if(accGrad) {
-        //horizontal gradient
-        hgrad = 2*(data[value(x+1,y,nx,ny)] - data[value(x-1,y,nx,ny)]) +
-          data[value(x+1,y+1,nx,ny)] - data[value(x-1,y+1,nx,ny)] +
-          data[value(x+1,y-1,nx,ny)] - data[value(x-1,y-1,nx,ny)];
-        //vertical gradient
-        vgrad = 2*(data[value(x,y+1,nx,ny)] - data[value(x,y-1,nx,ny)]) +
-          data[value(x+1,y+1,nx,ny)] - data[value(x+1,y-1,nx,ny)] +
-          data[value(x-1,y+1,nx,ny)] - data[value(x-1,y-1,nx,ny)] ;
-      }
-      else {
-        //horizontal gradient
-        hgrad = data[value(x+1,y,nx,ny)] - data[value(x-1,y,nx,ny)];
-        //vertical gradient
-        vgrad = data[value(x,y+1,nx,ny)] - data[value(x,y-1,nx,ny)];
-      }
-      // Gradient norm and dirextion
-      grad[y*nx+x] = hypot(hgrad,vgrad);
-      theta[y*nx + x] = atan2(vgrad,hgrad);
-    }
-  }
-  unsigned char *output = NULL;
-  output = (unsigned char *) xmalloc(sizeof(unsigned char) * nx * ny);
-
-  //Suppression of non-maxima
-  maxima(grad,theta,output,nx,ny,low_thr,high_thr);
-
-  int N = nx*ny;
-
-  int* t = (int *) xmalloc(sizeof(int) * nx * ny);
-
-  // Building the trees
-  adsf_begin(t,N);
-  for(size_t x = 0 ; x < nx ; x++)
-    for(size_t y = 0 ; y < ny ; y++) {
-      int d = x + nx * y;
-      if(output[d]) {
-        for(int ex = -1 ; ex < 2 ; ex++)
-          for(int ey = -1 ; ey < 2 ; ey++) {
-            int ed = value(x+ex,y+ey,nx,ny);
-            // If the neighbour is marked, we make the union
-            if(output[ed])
-              adsf_union(t,N,d,ed);
-          }
-      }
-    }
-
-    // We mark every tree having a node higher than the high threshold
-    for(int d = 0 ; d < N ; d++)
-      if(output[d] == 2)
-        output[adsf_find(t,N,d)] = 2;
-
-      adsf_assert_consistency(t,N);
-
-      // We remove every tree which root is not marked
-      for(int d = 0 ; d < N ; d++)
-        if(output[adsf_find(t,N,d)]  < 2)
-          output[d] = 0;
-        else
-          // Very high value so it can be seen
-          output[d] = (char) -1;
-        free(t);
-
-        free(grad);
-        free(theta);
-        free(data);
-
-
-
+    w->in[d] = (double) (unsigned char) image[d];
 
+  int nonzero = canny(w, s, low_thr, high_thr, accGrad);
 
   NumericMatrix out_r(Dimension(nx, ny));
-  int nonzero = 0;
-  for(int i = 0; i < int(nx * ny); i++){
-    out_r[i] = output[i];
-    if(output[i] == 255){
-      nonzero = nonzero + 1;
-    }
-  }
-  free(output);
-  delete[] input;
+  for(size_t d = 0; d < nx*ny; d++)
+    out_r[d] = w->output[d];
+  free_canny_workspace(w);
   List z = List::create(_["edges"] = out_r,
                         _["pixels_nonzero"] = nonzero,
                         _["nx"] = nx,
@@ -244,5 +382,81 @@ List canny_edge_detector(IntegerVector image, int X, int Y,
   return z;
 }
 
+// Edges of a sequence of images of the same size, given as an integer or raw vector
+// of X x Y x frames pixel values. Every thread gets its own workspace which it reuses
+// for all the frames it processes. With fewer frames than threads, the frames are
+// processed one by one and the threads share the bands of every frame.
+// [[Rcpp::export]]
+List canny_edge_detector_batch(SEXP image, int X, int Y, int frames,
+                               double s = 2,
+                               double low_thr = 3,
+                               double high_thr = 10,
+                               bool accGrad = false,
+                               int threads = 0)
+{
+  size_t n = (size_t)X*Y;
+  if(TYPEOF(image) != INTSXP && TYPEOF(image) != RAWSXP)
+    stop("image should be an integer or raw vector");
+  if(frames < 0 || (size_t)Rf_xlength(image) != n * frames)
+    stop("image should contain X * Y * frames pixels");
+  const int *pixels_int = TYPEOF(image) == INTSXP ? INTEGER(image) : NULL;
+  const unsigned char *pixels_raw = TYPEOF(image) == RAWSXP ? RAW(image) : NULL;
+
+  if(threads < 1) {
+    threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+  }
+  int teams = threads < frames ? threads : frames;
+  if(teams < 1) teams = 1;
+  canny_workspace **w = (canny_workspace **) xmalloc(sizeof(canny_workspace *) * teams);
+  for(int t = 0; t < teams; t++)
+    w[t] = make_canny_workspace(X, Y, teams > 1 ? 1 : threads);
+  // the blur of the threads must not plan FFTs
+  gblur_prepare(X, Y, s);
+
+  RawVector edges(n * frames);
+  IntegerVector nonzero(frames);
+  unsigned char *e = RAW(edges);
+  int *nz = INTEGER(nonzero);
+
+  #pragma omp parallel for schedule(dynamic) num_threads(teams) if(teams > 1)
+  for(int f = 0; f < frames; f++) {
+    int t = 0;
+#ifdef _OPENMP
+    t = omp_get_thread_num();
+#endif
+    canny_workspace *ws = w[t];
+    if(pixels_int)
+      for(size_t d = 0; d < n; d++)
+        ws->in[d] = (double) (unsigned char) pixels_int[n*f + d];
+    else
+      for(size_t d = 0; d < n; d++)
+        ws->in[d] = (double) pixels_raw[n*f + d];
+    nz[f] = canny(ws, s, low_thr, high_thr, accGrad);
+    for(size_t d = 0; d < n; d++)
+      e[n*f + d] = ws->output[d] != 0;
+  }
+  for(int t = 0; t < teams; t++)
+    free_canny_workspace(w[t]);
+  free(w);
 
+  edges.attr("dim") = IntegerVector::create(X, Y, frames);
+  List z = List::create(_["edges"] = edges,
+                        _["pixels_nonzero"] = nonzero,
+                        _["nx"] = X,
+                        _["ny"] = Y,
+                        _["frames"] = frames,
+                        _["s"] = s,
+                        _["low_thr"] = low_thr,
+                        _["high_thr"] = high_thr,
+                        _["accGrad"] = accGrad);
+  return z;
+}
 
+// [[Rcpp::export]]
+void canny_fftw_wisdom(std::string file)
+{
+  set_wisdom_file(file.c_str());
+}
@@ -77,117 +77,219 @@ void *xmalloc(size_t size)
 #define FORJ(n) for(int j=0;j<(n);j++)
 #define FORL(n) for(int l=0;l<(n);l++)
 
-#ifndef USE_WISDOM
-void evoke_wisdom(void) {}
-void bequeath_wisdom(void) {}
-#else//USE_WISDOM
-#include "fftwisdom.c"
-#endif//USE_WISDOM
-
-// wrapper around FFTW3 that computes the complex-valued Fourier transform
-// of a real-valued image
-static void fft_2ddouble(fftw_complex *fx, double *x, int w, int h)
-{
-	fftw_complex *a = fftw_malloc(w*h*sizeof*a);
+// real-to-complex and complex-to-real plans of one image size, which are
+// executed on the arrays of the caller (new-array execute interface)
+struct fft_plans {
+	int w, h;
+	fftw_plan forward, backward;
+};
 
-	//fprintf(stderr, "planning...\n");
-	evoke_wisdom();
-	fftw_plan p = fftw_plan_dft_2d(h, w, a, fx,
-						FFTW_FORWARD, FFTW_ESTIMATE);
-	bequeath_wisdom();
-	//fprintf(stderr, "...planned!\n");
+#define FFT_PLAN_CACHE 4
+static struct fft_plans plan_cache[FFT_PLAN_CACHE];
+static int plan_cache_next = 0;
 
-	FORI(w*h) a[i] = x[i]; // complex assignment!
-	fftw_execute(p);
+static void clear_fft_plans(void)
+{
+	FORI(FFT_PLAN_CACHE) {
+		if (plan_cache[i].forward) {
+			fftw_destroy_plan(plan_cache[i].forward);
+			fftw_destroy_plan(plan_cache[i].backward);
+		}
+		plan_cache[i].forward = plan_cache[i].backward = NULL;
+	}
+}
 
-	fftw_destroy_plan(p);
-	fftw_free(a);
-	fftw_cleanup();
+// FFTW wisdom is only read and written when a wisdom file has been set, in
+// which case plans are measured instead of estimated since the cost of
+// measuring is paid once for every image size
+static char *wisdom_file = NULL;
+static int wisdom_evoked = 0;
+
+void set_wisdom_file(const char *filename)
+{
+	free(wisdom_file);
+	wisdom_file = NULL;
+	wisdom_evoked = 0;
+	if (filename && *filename) {
+		wisdom_file = xmalloc(strlen(filename) + 1);
+		strcpy(wisdom_file, filename);
+	}
+	// plans made under the previous setting are made again
+	clear_fft_plans();
 }
 
-// Wrapper around FFTW3 that computes the real-valued inverse Fourier transform
-// of a complex-valued frequantial image.
-// The input data must be hermitic.
-static void ifft_2ddouble(double *ifx,  fftw_complex *fx, int w, int h)
+static void evoke_wisdom(void)
 {
-	fftw_complex *a = fftw_malloc(w*h*sizeof*a);
-	fftw_complex *b = fftw_malloc(w*h*sizeof*b);
+	if (wisdom_file && !wisdom_evoked)
+		fftw_import_wisdom_from_filename(wisdom_file);
+	wisdom_evoked = 1;
+}
 
-	//fprintf(stderr, "planning...\n");
-	evoke_wisdom();
-	fftw_plan p = fftw_plan_dft_2d(h, w, a, b,
-						FFTW_BACKWARD, FFTW_ESTIMATE);
-	bequeath_wisdom();
-	//fprintf(stderr, "...planned!\n");
+static void bequeath_wisdom(void)
+{
+	if (wisdom_file)
+		fftw_export_wisdom_to_filename(wisdom_file);
+}
 
-	FORI(w*h) a[i] = fx[i];
+static struct fft_plans *get_fft_plans(int w, int h)
+{
+	FORI(FFT_PLAN_CACHE)
+		if (plan_cache[i].forward && plan_cache[i].w == w
+				&& plan_cache[i].h == h)
+			return plan_cache + i;
 
-	fftw_execute(p);
-	double scale = 1.0/(w*h);
-	FORI(w*h) {
-		fftw_complex z = b[i] * scale;
-		ifx[i] = crealf(z);
-		assert(cimagf(z) < 0.001);
+	struct fft_plans *p = plan_cache + plan_cache_next;
+	plan_cache_next = (plan_cache_next + 1) % FFT_PLAN_CACHE;
+	if (p->forward) {
+		fftw_destroy_plan(p->forward);
+		fftw_destroy_plan(p->backward);
 	}
-	fftw_destroy_plan(p);
+
+	unsigned flags = wisdom_file ? FFTW_MEASURE : FFTW_ESTIMATE;
+	double *a = fftw_malloc(w*h*sizeof*a);
+	fftw_complex *fa = fftw_malloc(h*(w/2+1)*sizeof*fa);
+	evoke_wisdom();
+	p->forward = fftw_plan_dft_r2c_2d(h, w, a, fa, flags);
+	p->backward = fftw_plan_dft_c2r_2d(h, w, fa, a, flags);
+	bequeath_wisdom();
 	fftw_free(a);
-	fftw_free(b);
-	fftw_cleanup();
+	fftw_free(fa);
+	p->w = w;
+	p->h = h;
+	return p;
 }
 
-static void pointwise_complex_multiplication(fftw_complex *w,
-		fftw_complex *z, fftw_complex *x, int n)
+// Discrete Fourier transform along one axis of length n of the periodic
+// kernel exp(-x^2/s^2), x in [-n/2, n/2), normalized to sum 1.
+// The 2D kernel is separable, so the transfer function of the 2D blur is
+// the product of the transforms of both axes and no kernel image is needed.
+static void fill_gaussian_transfer(double *g, int n, double s)
 {
+	int r = ceil(6*s);
+	if (r > n/2)
+		r = n/2;
+	double *k = xmalloc((r+1)*sizeof*k);
+	double m = 1;
+	k[0] = 1;
+	for (int x = 1; x <= r; x++) {
+		k[x] = exp(-x*x/(s*s));
+		// x = n/2 only occurs once in the period, as -n/2
+		m += (2*x == n) ? k[x] : 2*k[x];
+	}
 	FORI(n) {
-		w[i] = z[i] * x[i];
+		double v = k[0];
+		for (int x = 1; x <= r; x++) {
+			double c = cos(2*M_PI*(((long)i*x) % n)/n);
+			v += (2*x == n) ? k[x]*c : 2*k[x]*c;
+		}
+		g[i] = v / m;
 	}
+	free(k);
 }
 
-static void fill_2d_gaussian_image(double *gg, int w, int h, double inv_s)
+// gaussian blur of a gray 2D image by multiplication in the frequency domain
+static void gblur_gray_fft(double *y, double *x, int w, int h, double s)
 {
-	double (*g)[w] = (void *)gg;
-	double alpha = inv_s*inv_s/(M_PI);
-
-	FORJ(h) FORI(w) {
-		double x = i < w/2 ? i : i - w;
-		double y = j < h/2 ? j : j - h;
-		double r = hypot(x, y);
-		g[j][i] = alpha * exp(-r*r*inv_s*inv_s);
-	}
+	int cw = w/2 + 1;
+	struct fft_plans *p = get_fft_plans(w, h);
 
-	// if the kernel is too large, it escapes the domain, so the
-	// normalization above must be corrected
-	double m = 0;
-	FORJ(h) FORI(w) m += g[j][i];
-	FORJ(h) FORI(w) g[j][i] /= m;
+	double *a = fftw_malloc(w*h*sizeof*a);
+	fftw_complex *fa = fftw_malloc(h*cw*sizeof*fa);
+	double *gx = xmalloc(w*sizeof*gx);
+	double *gy = xmalloc(h*sizeof*gy);
+	fill_gaussian_transfer(gx, w, s);
+	fill_gaussian_transfer(gy, h, s);
+
+	FORI(w*h) a[i] = x[i];
+	fftw_execute_dft_r2c(p->forward, a, fa);
+	double scale = 1.0/(w*h);
+	FORJ(h) FORI(cw)
+		fa[j*cw+i] *= gx[i] * gy[j] * scale;
+	fftw_execute_dft_c2r(p->backward, fa, a);
+	FORI(w*h) y[i] = a[i];
+
+	fftw_free(a);
+	fftw_free(fa);
+	free(gx);
+	free(gy);
 }
 
-// gaussian blur of a gray 2D image
-static void gblur_gray(double *y, double *x, int w, int h, double s)
+// Gaussian blur of a gray 2D image by direct convolution with the separable
+// kernel exp(-x^2/s^2) truncated at 4s, where it has dropped below 1e-7.
+// Indices wrap around as in the frequency domain, so both blurs agree.
+// The column pass accumulates whole rows so that the image is traversed
+// row by row.
+static void gblur_gray_direct(double *y, double *x, int w, int h, double s)
 {
-	s = 1/s;
+	int r = ceil(4*s);
+	double *g = xmalloc((2*r+1)*sizeof*g);
+	double m = 0;
+	for (int k = -r; k <= r; k++)
+		m += g[k+r] = exp(-k*k/(s*s));
+	FORI(2*r+1) g[i] /= m;
 
-	fftw_complex *fx = fftw_malloc(w*h*sizeof*fx);
-	fft_2ddouble(fx, x, w, h);
+	double (*in)[w] = (void *)x;
+	double (*out)[w] = (void *)y;
+	double *t = xmalloc(w*h*sizeof*t);
+	double (*tmp)[w] = (void *)t;
+	double *row = xmalloc((w+2*r)*sizeof*row);
+	FORJ(h) {
+		FORI(w+2*r)
+			row[i] = in[j][((i-r) % w + w) % w];
+		FORI(w) {
+			double v = 0;
+			for (int k = 0; k <= 2*r; k++)
+				v += g[k] * row[i+k];
+			tmp[j][i] = v;
+		}
+	}
+	FORJ(h) {
+		FORI(w) out[j][i] = 0;
+		for (int k = 0; k <= 2*r; k++) {
+			double *src = tmp[((j+k-r) % h + h) % h];
+			double gk = g[k];
+			FORI(w) out[j][i] += gk * src[i];
+		}
+	}
+	free(row);
+	free(t);
+	free(g);
+}
 
-	double *g = xmalloc(w*h*sizeof*g);
-	fill_2d_gaussian_image(g, w, h, s);
+// Below this width the direct convolution costs less than the transforms
+#define DIRECT_MAX_S 6.0
 
-	fftw_complex *fg = fftw_malloc(w*h*sizeof*fg);
-	fft_2ddouble(fg, g, w, h);
+static int gblur_is_direct(int w, int h, double s)
+{
+	return s <= DIRECT_MAX_S && 2*ceil(4*s) < w && 2*ceil(4*s) < h;
+}
 
-	pointwise_complex_multiplication(fx, fx, fg, w*h);
-	ifft_2ddouble(y, fx, w, h);
+// gaussian blur of a gray 2D image
+static void gblur_gray(double *y, double *x, int w, int h, double s)
+{
+	if (gblur_is_direct(w, h, s))
+		gblur_gray_direct(y, x, w, h, s);
+	else
+		gblur_gray_fft(y, x, w, h, s);
+}
 
-	fftw_free(fx);
-	fftw_free(fg);
-	free(g);
+// makes the FFTW plans gblur needs for w x h images, such that gblur
+// can afterwards be called from several threads at once for that size
+// (planning is not thread safe, executing a plan on new arrays is)
+void gblur_prepare(int w, int h, double s)
+{
+	if (!gblur_is_direct(w, h, s))
+		get_fft_plans(w, h);
 }
 
 // gausian blur of a 2D image with pd-dimensional pixels
 // (the blurring is performed independently for each co-ordinate)
 void gblur(double *y, double *x, int w, int h, int pd, double s)
 {
+	if (pd == 1) {
+		gblur_gray(y, x, w, h, s);
+		return;
+	}
 	double *c = xmalloc(w*h*sizeof*c);
 	double *gc = xmalloc(w*h*sizeof*gc);
 	FORL(pd) {
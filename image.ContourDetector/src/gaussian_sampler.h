@@ -0,0 +1,34 @@
+/*----------------------------------------------------------------------------
+
+  Separable Gaussian filtering and sub-sampling of graylevel images.
+
+  The same gaussian_sampler.c and gaussian_sampler.h are part of
+  image.ContourDetector and image.LineSegmentDetector, keep both copies
+  identical.
+
+  ----------------------------------------------------------------------------*/
+#ifndef GAUSSIAN_SAMPLER_HEADER
+#define GAUSSIAN_SAMPLER_HEADER
+
+/*----------------------------------------------------------------------------*/
+/* Filter the XxY image 'in' with a Gaussian kernel of standard deviation
+   'sigma' and sample the result at steps of 1/scale pixels, using the
+   symmetric boundary condition. With scale=1 this is a plain Gaussian filter.
+
+   Both images are arrays of doubles such that in[x+y*X] is the value at
+   coordinates x,y. 'out' must be allocated by the caller to a size N x M,
+   with N = ceil(X*scale) and M = ceil(Y*scale).
+
+   The kernel is truncated where it is 10^3 times smaller than its central
+   value. The convolution is computed in single precision.
+
+   The rows are filtered by 'threads' threads, or by the OpenMP default
+   number of threads when 'threads' is less than 1.
+
+   Returns 0 on success and -1 when out of memory.
+ */
+int gaussian_sampler_data( const double * in, int X, int Y, double * out,
+                           double scale, double sigma, int threads );
+
+#endif /* !GAUSSIAN_SAMPLER_HEADER */
+/*----------------------------------------------------------------------------*/
@@ -30,6 +30,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include <float.h>
+#include "gaussian_sampler.h"
 
 /*----------------------------------------------------------------------------*/
 #ifndef FALSE
@@ -146,117 +147,25 @@ static double erf_winitzki(double x)
   return sqrt( 1.0 - exp(-x*x * (4.0/M_PI + a*x*x) / (1.0 + a*x*x)) );
 }
 
-/*----------------------------------------------------------------------------*/
-/* compute a Gaussian kernel of length n, standard deviation sigma,
-   and centered at value mean.
-
-   for example, if mean=0.5, the Gaussian will be centered in the middle point
-   between values kernel[0] and kernel[1].
-
-   kernel must be allocated to a size n.
- */
-static void gaussian_kernel(double * kernel, int n, double sigma, double mean)
-{
-  double sum = 0.0;
-  double val;
-  int i;
-
-  /* check input */
-  if( kernel == NULL ) error("gaussian_kernel: kernel not allocated");
-  if( sigma <= 0.0 ) error("gaussian_kernel: sigma must be positive");
-
-  /* compute Gaussian kernel */
-  for(i=0; i<n; i++)
-    {
-      val = ( (double) i - mean ) / sigma;
-      kernel[i] = exp( -0.5 * val * val );
-      sum += kernel[i];
-    }
-
-  /* normalization */
-  if( sum > 0.0 ) for(i=0; i<n; i++) kernel[i] /= sum;
-}
-
 /*----------------------------------------------------------------------------*/
 /* filter an image with a Gaussian kernel of parameter sigma. return a pointer
    to a newly allocated filtered image, of the same size as the input image.
+   the separable convolution with symmetric boundary condition is done by
+   gaussian_sampler_data at scale 1.
  */
 static double * gaussian_filter(double * image, int X, int Y, double sigma)
 {
-  int x,y,offset,i,j,nx2,ny2,n;
-  double * kernel;
-  double * tmp;
   double * out;
-  double val,prec;
 
   /* check input */
   if( sigma <= 0.0 ) error("gaussian_filter: sigma must be positive");
   if( image == NULL || X < 1 || Y < 1 ) error("gaussian_filter: invalid image");
 
   /* get memory */
-  tmp = (double *) xmalloc( X * Y * sizeof(double) );
   out = (double *) xmalloc( X * Y * sizeof(double) );
 
-  /* compute gaussian kernel */
-  /*
-     The size of the kernel is selected to guarantee that the first discarded
-     term is at least 10^prec times smaller than the central value. For that,
-     the half size of the kernel must be larger than x, with
-       e^(-x^2/2sigma^2) = 1/10^prec
-     Then,
-       x = sigma * sqrt( 2 * prec * ln(10) )
-   */
-  prec = 3.0;
-  offset = (int) ceil( sigma * sqrt( 2.0 * prec * log(10.0) ) );
-  n = 1 + 2 * offset; /* kernel size */
-  kernel = (double *) xmalloc( n * sizeof(double) );
-  gaussian_kernel(kernel, n, sigma, (double) offset);
-
-  /* auxiliary variables for the double of the image size */
-  nx2 = 2*X;
-  ny2 = 2*Y;
-
-  /* x axis convolution */
-  for(x=0; x<X; x++)
-    for(y=0; y<Y; y++)
-      {
-        val = 0.0;
-        for(i=0; i<n; i++)
-          {
-            j = x - offset + i;
-
-            /* symmetry boundary condition */
-            while(j<0) j += nx2;
-            while(j>=nx2) j -= nx2;
-            if( j >= X ) j = nx2-1-j;
-
-            val += image[j+y*X] * kernel[i];
-          }
-        tmp[x+y*X] = val;
-      }
-
-  /* y axis convolution */
-  for(x=0; x<X; x++)
-    for(y=0; y<Y; y++)
-      {
-        val = 0.0;
-        for(i=0; i<n; i++)
-          {
-            j = y - offset + i;
-
-            /* symmetry boundary condition */
-            while(j<0) j += ny2;
-            while(j>=ny2) j -= ny2;
-            if( j >= Y ) j = ny2-1-j;
-
-            val += tmp[x+j*X] * kernel[i];
-          }
-        out[x+y*X] = val;
-      }
-
-  /* free memory */
-  free( (void *) kernel );
-  free( (void *) tmp );
+  if( gaussian_sampler_data(image, X, Y, out, 1.0, sigma, 0) != 0 )
+    error("gaussian_filter: out of memory");
 
   return out;
 }
@@ -1201,23 +1110,42 @@ static void get_region( int * n, struct region * reg,
   qsort( (void *) reg, (size_t) *n, sizeof(struct region), &comp_region );
 }
 
+/*----------------------------------------------------------------------------*/
+/* state of the Mann-Whitney U statistic of one lateral region width and gap
+   while the region is traversed in order of increasing value
+ */
+struct rank_sum
+{
+  int n1,n2;            /* number of pixels in region 1 and 2 */
+  int rank;             /* rank of the last pixel inside the width */
+  int sum_tied_ranks;   /* sum of ranks of the current tied pixel group */
+  int num_tied;         /* size of the current tied pixel group */
+  int num_tied_r2;      /* pixels of the current tied group in region 2 */
+  double tie_val;       /* value of the current tied pixel group */
+  double sum_rank_r2;   /* sum of ranks in region 2 */
+};
+
 /*----------------------------------------------------------------------------*/
 /* compute arc NFA using Mann-Whitney U test
    http://en.wikipedia.org/wiki/Mann%E2%80%93Whitney_U_test
 
-   input: X,Y is the image size, arc is a pointer to the arc, w is the width
-          of the lateral regions of the current arc operator, reg is a pointer
-          to the lateral regions of size n, W is the number of width used in
-          the method, and gap is the size in pixel units of the space to
-          separate both regions.
+   the NFA is computed for nt operators at once, in a single pass over the
+   region. operator j has lateral regions of width w[j], separated by a
+   central gap of gap[j] pixels.
 
-   return: log(NFA)
+   input: X,Y is the image size, arc is a pointer to the arc, nt is the number
+          of operators, w and gap are their widths and gaps, rs is scratch
+          memory for nt operators, reg is a pointer to the lateral regions of
+          size n, and W is the number of width used in the method.
+
+   output: log_nfa[j] is the log(NFA) of operator j.
  */
-static double arc_log_nfa( int X, int Y, struct arc_of_circle * arc, double w,
-                           int n, struct region * reg, int W, double gap )
+static void arc_log_nfa( int X, int Y, struct arc_of_circle * arc,
+                         int nt, double * w, double * gap, struct rank_sum * rs,
+                         double * log_nfa, int n, struct region * reg, int W )
 {
-  int n1,n2,i,rank,sum_tied_ranks,num_tied,num_tied_r2;
-  double tie_val,adjusted_rank,sum_rank_r2,u,m,s,z,pvalue;
+  int i,j;
+  double u,m,s,z,pvalue;
 
   /* Number of Tests: NT = sqrt(XY) * XY * (4 + pi^2)/3 * l^2 * num_width
 
@@ -1249,63 +1177,86 @@ static double arc_log_nfa( int X, int Y, struct arc_of_circle * arc, double w,
      completed, its adjusted rank can be assigned, and the corresponding
      quantity added to the sum of ranks in region 2. the variables are updated
      to reflect the new tied group including initially only the new pixel.
+
+     each operator keeps its own variables, as pixels outside its width are
+     not ranked.
    */
-  n1 = n2 = 0;
-  sum_rank_r2 = 0.0;
-  rank = 0;
-  tie_val = reg[0].val;  /* set tied pixel group for the first pixel in reg */
-  sum_tied_ranks = num_tied = num_tied_r2 = 0;
+  for(j=0; j<nt; j++)
+    {
+      rs[j].n1 = rs[j].n2 = 0;
+      rs[j].sum_rank_r2 = 0.0;
+      rs[j].rank = 0;
+      rs[j].tie_val = reg[0].val; /* set tied pixel group for the first pixel */
+      rs[j].sum_tied_ranks = rs[j].num_tied = rs[j].num_tied_r2 = 0;
+    }
   for(i=0; i<n; i++)
-    if( reg[i].w > 0.5*gap && reg[i].w <= w ) /* evaluate only pixels inside
-                                                 the current width */
-      {
-        if( greater(reg[i].val, tie_val) ) /* a new tied pixel group */
-          {
-            /* compute the adjusted rank and assign the rank values of region 2
-               in the last tied pixel group */
-            if( num_tied > 0 && num_tied_r2 > 0 )
-              {
-                adjusted_rank = (double) sum_tied_ranks / (double) num_tied;
-                sum_rank_r2 += (double) num_tied_r2 * adjusted_rank;
-              }
+    for(j=0; j<nt; j++)
+      if( reg[i].w > 0.5*gap[j] && reg[i].w <= w[j] ) /* evaluate only pixels
+                                                         inside the width */
+        {
+          struct rank_sum * r = rs + j;
 
-            /* initialize new tied pixel group */
-            tie_val = reg[i].val;
-            sum_tied_ranks = num_tied = num_tied_r2 = 0;
-          }
+          if( greater(reg[i].val, r->tie_val) ) /* a new tied pixel group */
+            {
+              /* compute the adjusted rank and assign the rank values of
+                 region 2 in the last tied pixel group */
+              if( r->num_tied > 0 && r->num_tied_r2 > 0 )
+                {
+                  double adjusted_rank = (double) r->sum_tied_ranks
+                                       / (double) r->num_tied;
+                  r->sum_rank_r2 += (double) r->num_tied_r2 * adjusted_rank;
+                }
+
+              /* initialize new tied pixel group */
+              r->tie_val = reg[i].val;
+              r->sum_tied_ranks = r->num_tied = r->num_tied_r2 = 0;
+            }
 
-        ++rank; /* rank in the ordering among the pixels in the region */
-        sum_tied_ranks += rank;
-        ++num_tied;
+          ++r->rank; /* rank in the ordering among the pixels in the region */
+          r->sum_tied_ranks += r->rank;
+          ++r->num_tied;
 
-        /* count pixels in region 1 and 2 */
-        if( reg[i].reg == 1 ) ++n1;
-        else
-          {
-            ++n2;
-            ++num_tied_r2;
-          }
-      }
-  if( num_tied > 0 && num_tied_r2 > 0 ) /* assign ranks of last tied group */
-    sum_rank_r2 += (double) num_tied_r2 * sum_tied_ranks / num_tied;
-  u = sum_rank_r2 - 0.5 * n2 * (n2 + 1.0); /* compute u value */
-
-  /* compute z, a version of u with standard normal distribution, N(0,1) */
-  m = 0.5 * n1 * n2;
-  s = sqrt( n1 * n2 * (n1+n2+1.0) / 12.0 );
-  if( n1 > 0 && n2 > 0 && s > 0.0 ) z = (u - m) / s;
-  else return logNT; /* one of the regions has no pixel => not meaningful */
-
-  /* compute the p-value using the standard error function */
-  pvalue = 0.5 * ( 1.0 - erf_winitzki(z/sqrt(2.0)) );
-  if( pvalue <= 0.0 ) /* the p-value should always be larger than zero.
-                         this condition reveals a numeric overflow,
-                         due to a very very small p-value. then the arc
-                         is meaningful => return a negative log10(NFA) */
-    return (double) DBL_MIN_10_EXP; /* minimal negative exponent in doubles */
-
-  /* return the log10(NFA) */
-  return logNT + log10(pvalue);
+          /* count pixels in region 1 and 2 */
+          if( reg[i].reg == 1 ) ++r->n1;
+          else
+            {
+              ++r->n2;
+              ++r->num_tied_r2;
+            }
+        }
+
+  for(j=0; j<nt; j++)
+    {
+      struct rank_sum * r = rs + j;
+      int n1 = r->n1;
+      int n2 = r->n2;
+
+      if( r->num_tied > 0 && r->num_tied_r2 > 0 ) /* ranks of last tied group */
+        r->sum_rank_r2 += (double) r->num_tied_r2 * r->sum_tied_ranks
+                        / r->num_tied;
+      u = r->sum_rank_r2 - 0.5 * n2 * (n2 + 1.0); /* compute u value */
+
+      /* compute z, a version of u with standard normal distribution, N(0,1) */
+      m = 0.5 * n1 * n2;
+      s = sqrt( n1 * n2 * (n1+n2+1.0) / 12.0 );
+      if( n1 > 0 && n2 > 0 && s > 0.0 ) z = (u - m) / s;
+      else
+        {
+          log_nfa[j] = logNT; /* one of the regions has no pixel
+                                 => not meaningful */
+          continue;
+        }
+
+      /* compute the p-value using the standard error function */
+      pvalue = 0.5 * ( 1.0 - erf_winitzki(z/sqrt(2.0)) );
+      if( pvalue <= 0.0 ) /* the p-value should always be larger than zero.
+                             this condition reveals a numeric overflow,
+                             due to a very very small p-value. then the arc
+                             is meaningful => return a negative log10(NFA) */
+        log_nfa[j] = (double) DBL_MIN_10_EXP; /* minimal negative exponent */
+      else
+        log_nfa[j] = logNT + log10(pvalue); /* the log10(NFA) */
+    }
 }
 
 /*----------------------------------------------------------------------------*/
@@ -1477,7 +1428,6 @@ void smooth_contours( double ** x, double ** y, int * N,
 
   double max_w = min_w * pow( fac_w, (double) num_w-1.0 );
   double sigma = sigma_step * sqrt( dog_rate * dog_rate - 1.0 );
-  struct region * reg = xmalloc( X * Y * sizeof(struct region) );
   double * diff = (double *) xmalloc( X * Y * sizeof(double) );
   int * meaningful = (int *) xmalloc( X * Y * sizeof(int) );
   int * used = (int *) xmalloc( X * Y * sizeof(int) );
@@ -1485,11 +1435,22 @@ void smooth_contours( double ** x, double ** y, int * N,
   double * xx;
   double * yy;
   int * curve;
-  struct arc_of_circle arc;
-  arc.dir  = 0;
-  int i,k,n,reg_n,c,NN,MM,min_l;
+  double * op_w;     /* width and gap of the operators */
+  double * op_gap;
+  int nt = 0;        /* number of operators */
+  int n,c,NN,MM,min_l;
   double w;
 
+  /* lateral width loop. two gaps are tried for each: 0.0 and 1.0 */
+  for(w=min_w; w<=max_w; w*=fac_w) nt += 2;
+  op_w = (double *) xmalloc( nt * sizeof(double) );
+  op_gap = (double *) xmalloc( nt * sizeof(double) );
+  for(n=0, w=min_w; w<=max_w; w*=fac_w)
+    {
+      op_w[n] = w; op_gap[n++] = 0.0;
+      op_w[n] = w; op_gap[n++] = 1.0;
+    }
+
   /* compute minimal arc length that may become meaningful */
   min_l = compute_min_length(X,Y,max_w,W,log_eps);
 
@@ -1503,30 +1464,60 @@ void smooth_contours( double ** x, double ** y, int * N,
   /* initialize all edge points as not meaningful and not used */
   for(n=0; n<NN; n++) meaningful[n] = used[n] = FALSE;
 
-  /* a-contrario validation of curve segments approximated by local arcs */
-  for(c=0; c<MM; c++)                         /* iterate on curves */
-    for(i=curve[c]; i<curve[c+1]; i++)        /* first point of curve segment */
-      for(k=curve[c+1]-1; (k-i)>=min_l; k--)  /* last point of curve segment  */
-        if( !used[i] || !used[k] )   /* test segment only if one end not used */
-          if( smooth_segment(&arc,xx,yy,i,k,sigma,max_w,X,Y) )
-            {
-              /* heuristic to speed up: mark as used center part of segment */
-              for(n=i+3; n<=(k-3); n++) used[n] = TRUE;
-
-              /* get pixel values in lateral regions to the arc. to speed-up
-                 it is done only once, thus outside w-loop and arc_log_nfa() */
-              get_region(&reg_n, reg, diff, X, Y, &arc, max_w, Q);
-              if( reg_n <= 0 ) continue; /* empty region */
-
-              /* lateral width loop. two gaps are tried for each: 0.0 and 1.0 */
-              for(w=min_w; w<=max_w; w*=fac_w)
-                if( arc_log_nfa(X,Y,&arc,w,reg_n,reg,W,0.0) < log_eps ||
-                    arc_log_nfa(X,Y,&arc,w,reg_n,reg,W,1.0) < log_eps )
+  /* a-contrario validation of curve segments approximated by local arcs.
+     curves are independent: the points of a curve are only marked while
+     validating that curve, so curves are distributed over the threads and
+     each thread has its own lateral regions, grown to the largest bounding
+     box of the arcs it evaluates */
+#pragma omp parallel
+  {
+    struct region * reg = NULL;
+    int reg_size = 0;
+    struct rank_sum * rs = (struct rank_sum *)
+                           xmalloc( nt * sizeof(struct rank_sum) );
+    double * log_nfa = (double *) xmalloc( nt * sizeof(double) );
+    struct arc_of_circle arc;
+    int i,k,j,m,reg_n;
+    arc.dir = 0;
+
+#pragma omp for schedule(dynamic)
+    for(c=0; c<MM; c++)                         /* iterate on curves */
+      for(i=curve[c]; i<curve[c+1]; i++)        /* first point of curve segment */
+        for(k=curve[c+1]-1; (k-i)>=min_l; k--)  /* last point of curve segment  */
+          if( !used[i] || !used[k] )   /* test segment only if one end not used */
+            if( smooth_segment(&arc,xx,yy,i,k,sigma,max_w,X,Y) )
+              {
+                /* heuristic to speed up: mark as used center part of segment */
+                for(m=i+3; m<=(k-3); m++) used[m] = TRUE;
+
+                /* the lateral regions lie inside the arc bounding box */
+                m = (arc.bbx1 - arc.bbx0) * (arc.bby1 - arc.bby0);
+                if( m > reg_size )
                   {
-                    for(n=i; n<=k; n++) meaningful[n] = used[n] = TRUE;
-                    break; /* arc already meaningful, no need to test other w */
+                    free( (void *) reg );
+                    reg = (struct region *) xmalloc( m * sizeof(struct region) );
+                    reg_size = m;
                   }
-            }
+
+                /* get pixel values in lateral regions to the arc. to speed-up
+                   it is done only once, for the largest width, and all the
+                   operators are evaluated in one pass by arc_log_nfa() */
+                get_region(&reg_n, reg, diff, X, Y, &arc, max_w, Q);
+                if( reg_n <= 0 ) continue; /* empty region */
+
+                arc_log_nfa(X,Y,&arc,nt,op_w,op_gap,rs,log_nfa,reg_n,reg,W);
+                for(j=0; j<nt; j++)
+                  if( log_nfa[j] < log_eps )
+                    {
+                      for(m=i; m<=k; m++) meaningful[m] = used[m] = TRUE;
+                      break; /* arc already meaningful */
+                    }
+              }
+
+    free( (void *) reg );
+    free( (void *) rs );
+    free( (void *) log_nfa );
+  }
 
   keep_meaningful_curves(x,y,N,curve_limits,M,xx,yy,NN,curve,MM,meaningful);
 
@@ -1538,6 +1529,7 @@ void smooth_contours( double ** x, double ** y, int * N,
   free( (void *) xx );
   free( (void *) yy );
   free( (void *) curve );
-  free( (void *) reg );
+  free( (void *) op_w );
+  free( (void *) op_gap );
 }
 /*----------------------------------------------------------------------------*/
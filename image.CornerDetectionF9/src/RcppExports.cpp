@@ -5,25 +5,67 @@
 
 using namespace Rcpp;
 
+// f9_context_new
+SEXP f9_context_new();
+RcppExport SEXP _image_CornerDetectionF9_f9_context_new() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(f9_context_new());
+    return rcpp_result_gen;
+END_RCPP
+}
+// f9_context_valid
+bool f9_context_valid(SEXP context);
+RcppExport SEXP _image_CornerDetectionF9_f9_context_valid(SEXP contextSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type context(contextSEXP);
+    rcpp_result_gen = Rcpp::wrap(f9_context_valid(context));
+    return rcpp_result_gen;
+END_RCPP
+}
 // detect_corners
-List detect_corners(IntegerVector x, int width, int height, int bytes_per_row, bool suppress_non_max, unsigned char threshold);
-RcppExport SEXP _image_CornerDetectionF9_detect_corners(SEXP xSEXP, SEXP widthSEXP, SEXP heightSEXP, SEXP bytes_per_rowSEXP, SEXP suppress_non_maxSEXP, SEXP thresholdSEXP) {
+List detect_corners(SEXP x, int width, int height, int bytes_per_row, bool suppress_non_max, unsigned char threshold, SEXP context);
+RcppExport SEXP _image_CornerDetectionF9_detect_corners(SEXP xSEXP, SEXP widthSEXP, SEXP heightSEXP, SEXP bytes_per_rowSEXP, SEXP suppress_non_maxSEXP, SEXP thresholdSEXP, SEXP contextSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< IntegerVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
     Rcpp::traits::input_parameter< int >::type width(widthSEXP);
     Rcpp::traits::input_parameter< int >::type height(heightSEXP);
     Rcpp::traits::input_parameter< int >::type bytes_per_row(bytes_per_rowSEXP);
     Rcpp::traits::input_parameter< bool >::type suppress_non_max(suppress_non_maxSEXP);
     Rcpp::traits::input_parameter< unsigned char >::type threshold(thresholdSEXP);
-    rcpp_result_gen = Rcpp::wrap(detect_corners(x, width, height, bytes_per_row, suppress_non_max, threshold));
+    Rcpp::traits::input_parameter< SEXP >::type context(contextSEXP);
+    rcpp_result_gen = Rcpp::wrap(detect_corners(x, width, height, bytes_per_row, suppress_non_max, threshold, context));
+    return rcpp_result_gen;
+END_RCPP
+}
+// detect_corners_batch
+List detect_corners_batch(SEXP x, int width, int height, int frames, bool suppress_non_max, unsigned char threshold, int threads);
+RcppExport SEXP _image_CornerDetectionF9_detect_corners_batch(SEXP xSEXP, SEXP widthSEXP, SEXP heightSEXP, SEXP framesSEXP, SEXP suppress_non_maxSEXP, SEXP thresholdSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
+    Rcpp::traits::input_parameter< int >::type width(widthSEXP);
+    Rcpp::traits::input_parameter< int >::type height(heightSEXP);
+    Rcpp::traits::input_parameter< int >::type frames(framesSEXP);
+    Rcpp::traits::input_parameter< bool >::type suppress_non_max(suppress_non_maxSEXP);
+    Rcpp::traits::input_parameter< unsigned char >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(detect_corners_batch(x, width, height, frames, suppress_non_max, threshold, threads));
     return rcpp_result_gen;
 END_RCPP
 }
 
 static const R_CallMethodDef CallEntries[] = {
-    {"_image_CornerDetectionF9_detect_corners", (DL_FUNC) &_image_CornerDetectionF9_detect_corners, 6},
+    {"_image_CornerDetectionF9_f9_context_new", (DL_FUNC) &_image_CornerDetectionF9_f9_context_new, 0},
+    {"_image_CornerDetectionF9_f9_context_valid", (DL_FUNC) &_image_CornerDetectionF9_f9_context_valid, 1},
+    {"_image_CornerDetectionF9_detect_corners", (DL_FUNC) &_image_CornerDetectionF9_detect_corners, 7},
+    {"_image_CornerDetectionF9_detect_corners_batch", (DL_FUNC) &_image_CornerDetectionF9_detect_corners_batch, 7},
     {NULL, NULL, 0}
 };
 
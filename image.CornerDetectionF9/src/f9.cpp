@@ -31,13 +31,22 @@
 
 #define BUILDING_F9
 #include "f9.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 class F9::Impl {
 private:
 	std::vector<F9_CORNER>  ret_corners;
 	std::vector<F9_CORNER>  nonmax;
 	std::vector<int>       scores;
+	std::vector<int>       nonmax_scores;
+	bool                   suppressed;
 	std::vector<int>       row_start;
+	std::vector<std::vector<F9_CORNER> > band_corners;
 
 	static inline void makeOffsets(int pixel[], int stride) {
 		pixel[ 0] =  0 + stride *  3;
@@ -61,7 +70,7 @@ private:
 	Impl(const Impl&);
 	Impl& operator=(const Impl&);
 public:
-	Impl() { }
+	Impl(): suppressed(false) { }
 
 	const std::vector<F9_CORNER>& detectCorners(
 	    const unsigned char* image_data,
@@ -69,20 +78,31 @@ public:
 	    int height,
 	    int bytes_per_row,
 	    unsigned char threshold,
-	    bool suppress_non_max
+	    bool suppress_non_max,
+	    bool compute_scores
 	) {
 		detectAllCorners(image_data, width, height, bytes_per_row, threshold);
+		suppressed = suppress_non_max;
+
+		if(suppress_non_max || compute_scores)
+			cornersScores(image_data, bytes_per_row, threshold);
+		else
+			scores.clear();
 
 		if(!suppress_non_max)
 			return ret_corners;
 
-		cornersScores(image_data, bytes_per_row, threshold);
 		nonMaxSuppression();
 		return nonmax;
 	}
 
+	const std::vector<int>& cornerScores() const {
+		return suppressed ? nonmax_scores : scores;
+	}
+
 	void nonMaxSuppression() {
 		nonmax.clear();
+		nonmax_scores.clear();
 
 		if(ret_corners.empty())
 			return;
@@ -165,6 +185,7 @@ public:
 			}
 
 			nonmax.push_back(ret_corners[i]);
+			nonmax_scores.push_back(score);
 		}
 	}
 
@@ -2946,139 +2967,78 @@ end_if:
 		int pixel[16];
 		makeOffsets(pixel, stride);
 
+		#pragma omp parallel for schedule(static) if(ret_corners.size() > 4096)
 		for(n = 0; n < (int) ret_corners.size(); ++n)
 			scores[n] = cornerScore(i + ret_corners[n].y * stride + ret_corners[n].x, pixel, b);
 	}
 
-	void detectAllCorners(const unsigned char* im, int xsize, int ysize, int stride, unsigned char b) {
-		ret_corners.clear();
-		int pixel[16];
-		makeOffsets(pixel, stride);
-		F9_CORNER xy;
-
-		for(xy.y = 3; xy.y < ysize - 3; ++xy.y)
-			for(xy.x = 3; xy.x < xsize - 3; ++xy.x) {
-				const unsigned char* p = im + xy.y * stride + xy.x;
-				const unsigned char cb((*p > 255 - b) ? 255 : *p + b);
-				const unsigned char c_b((*p < b) ? 0 : *p - b);
+	// FAST-9 segment test of the pixel at p: are 9 contiguous pixels of its
+	// circle all brighter than *p + b, or all darker than *p - b? This is the
+	// generated decision tree, used for the pixels the 16-wide test can't reach
+	// and when SSE2 is not available.
+	static bool isCorner(const unsigned char* p, const int pixel[], unsigned char b) {
+		const unsigned char cb((*p > 255 - b) ? 255 : *p + b);
+		const unsigned char c_b((*p < b) ? 0 : *p - b);
 
-				if(p[pixel[0]] > cb)
-					if(p[pixel[1]] > cb)
-						if(p[pixel[2]] > cb)
-							if(p[pixel[3]] > cb)
-								if(p[pixel[4]] > cb)
-									if(p[pixel[5]] > cb)
-										if(p[pixel[6]] > cb)
-											if(p[pixel[7]] > cb)
-												if(p[pixel[8]] > cb) {
-												}
-												else if(p[pixel[15]] > cb) {
-												}
-												else
-													continue;
-											else if(p[pixel[7]] < c_b)
-												if(p[pixel[14]] > cb)
-													if(p[pixel[15]] > cb) {
-													}
-													else
-														continue;
-												else if(p[pixel[14]] < c_b)
-													if(p[pixel[8]] < c_b)
-														if(p[pixel[9]] < c_b)
-															if(p[pixel[10]] < c_b)
-																if(p[pixel[11]] < c_b)
-																	if(p[pixel[12]] < c_b)
-																		if(p[pixel[13]] < c_b)
-																			if(p[pixel[15]] < c_b) {
-																			}
-																			else
-																				continue;
-																		else
-																			continue;
-																	else
-																		continue;
-																else
-																	continue;
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[14]] > cb)
-												if(p[pixel[15]] > cb) {
-												}
-												else
-													continue;
+		if(p[pixel[0]] > cb)
+			if(p[pixel[1]] > cb)
+				if(p[pixel[2]] > cb)
+					if(p[pixel[3]] > cb)
+						if(p[pixel[4]] > cb)
+							if(p[pixel[5]] > cb)
+								if(p[pixel[6]] > cb)
+									if(p[pixel[7]] > cb)
+										if(p[pixel[8]] > cb) {
+										}
+										else if(p[pixel[15]] > cb) {
+										}
+										else
+											return false;
+									else if(p[pixel[7]] < c_b)
+										if(p[pixel[14]] > cb)
+											if(p[pixel[15]] > cb) {
+											}
 											else
-												continue;
-										else if(p[pixel[6]] < c_b)
-											if(p[pixel[15]] > cb)
-												if(p[pixel[13]] > cb)
-													if(p[pixel[14]] > cb) {
-													}
-													else
-														continue;
-												else if(p[pixel[13]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b)
-															if(p[pixel[9]] < c_b)
-																if(p[pixel[10]] < c_b)
-																	if(p[pixel[11]] < c_b)
-																		if(p[pixel[12]] < c_b)
-																			if(p[pixel[14]] < c_b) {
-																			}
-																			else
-																				continue;
-																		else
-																			continue;
-																	else
-																		continue;
-																else
-																	continue;
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[7]] < c_b)
-												if(p[pixel[8]] < c_b)
-													if(p[pixel[9]] < c_b)
-														if(p[pixel[10]] < c_b)
-															if(p[pixel[11]] < c_b)
-																if(p[pixel[12]] < c_b)
-																	if(p[pixel[13]] < c_b)
-																		if(p[pixel[14]] < c_b) {
-																		}
-																		else
-																			continue;
+												return false;
+										else if(p[pixel[14]] < c_b)
+											if(p[pixel[8]] < c_b)
+												if(p[pixel[9]] < c_b)
+													if(p[pixel[10]] < c_b)
+														if(p[pixel[11]] < c_b)
+															if(p[pixel[12]] < c_b)
+																if(p[pixel[13]] < c_b)
+																	if(p[pixel[15]] < c_b) {
+																	}
 																	else
-																		continue;
+																		return false;
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[13]] > cb)
-											if(p[pixel[14]] > cb)
-												if(p[pixel[15]] > cb) {
-												}
-												else
-													continue;
+												return false;
+										else
+											return false;
+									else if(p[pixel[14]] > cb)
+										if(p[pixel[15]] > cb) {
+										}
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[6]] < c_b)
+									if(p[pixel[15]] > cb)
+										if(p[pixel[13]] > cb)
+											if(p[pixel[14]] > cb) {
+											}
 											else
-												continue;
+												return false;
 										else if(p[pixel[13]] < c_b)
 											if(p[pixel[7]] < c_b)
 												if(p[pixel[8]] < c_b)
@@ -3086,2631 +3046,2793 @@ end_if:
 														if(p[pixel[10]] < c_b)
 															if(p[pixel[11]] < c_b)
 																if(p[pixel[12]] < c_b)
-																	if(p[pixel[14]] < c_b)
-																		if(p[pixel[15]] < c_b) {
-																		}
-																		else
-																			continue;
+																	if(p[pixel[14]] < c_b) {
+																	}
 																	else
-																		continue;
+																		return false;
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[5]] < c_b)
-										if(p[pixel[14]] > cb)
-											if(p[pixel[12]] > cb)
-												if(p[pixel[13]] > cb)
-													if(p[pixel[15]] > cb) {
-													}
-													else if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb)
-															if(p[pixel[8]] > cb)
-																if(p[pixel[9]] > cb)
-																	if(p[pixel[10]] > cb)
-																		if(p[pixel[11]] > cb) {
-																		}
-																		else
-																			continue;
-																	else
-																		continue;
+											return false;
+									else if(p[pixel[7]] < c_b)
+										if(p[pixel[8]] < c_b)
+											if(p[pixel[9]] < c_b)
+												if(p[pixel[10]] < c_b)
+													if(p[pixel[11]] < c_b)
+														if(p[pixel[12]] < c_b)
+															if(p[pixel[13]] < c_b)
+																if(p[pixel[14]] < c_b) {
+																}
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
-											else if(p[pixel[12]] < c_b)
-												if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b)
-															if(p[pixel[9]] < c_b)
-																if(p[pixel[10]] < c_b)
-																	if(p[pixel[11]] < c_b)
-																		if(p[pixel[13]] < c_b) {
-																		}
-																		else
-																			continue;
-																	else
-																		continue;
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[13]] > cb)
+									if(p[pixel[14]] > cb)
+										if(p[pixel[15]] > cb) {
+										}
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[13]] < c_b)
+									if(p[pixel[7]] < c_b)
+										if(p[pixel[8]] < c_b)
+											if(p[pixel[9]] < c_b)
+												if(p[pixel[10]] < c_b)
+													if(p[pixel[11]] < c_b)
+														if(p[pixel[12]] < c_b)
+															if(p[pixel[14]] < c_b)
+																if(p[pixel[15]] < c_b) {
+																}
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[14]] < c_b)
-											if(p[pixel[7]] < c_b)
-												if(p[pixel[8]] < c_b)
-													if(p[pixel[9]] < c_b)
-														if(p[pixel[10]] < c_b)
-															if(p[pixel[11]] < c_b)
-																if(p[pixel[12]] < c_b)
-																	if(p[pixel[13]] < c_b)
-																		if(p[pixel[6]] < c_b) {
-																		}
-																		else if(p[pixel[15]] < c_b) {
-																		}
-																		else
-																			continue;
-																	else
-																		continue;
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else if(p[pixel[5]] < c_b)
+								if(p[pixel[14]] > cb)
+									if(p[pixel[12]] > cb)
+										if(p[pixel[13]] > cb)
+											if(p[pixel[15]] > cb) {
+											}
+											else if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb)
+													if(p[pixel[8]] > cb)
+														if(p[pixel[9]] > cb)
+															if(p[pixel[10]] > cb)
+																if(p[pixel[11]] > cb) {
+																}
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[6]] < c_b)
+												return false;
+										else
+											return false;
+									else if(p[pixel[12]] < c_b)
+										if(p[pixel[6]] < c_b)
 											if(p[pixel[7]] < c_b)
 												if(p[pixel[8]] < c_b)
 													if(p[pixel[9]] < c_b)
 														if(p[pixel[10]] < c_b)
 															if(p[pixel[11]] < c_b)
-																if(p[pixel[12]] < c_b)
-																	if(p[pixel[13]] < c_b) {
-																	}
-																	else
-																		continue;
+																if(p[pixel[13]] < c_b) {
+																}
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[12]] > cb)
-										if(p[pixel[13]] > cb)
-											if(p[pixel[14]] > cb)
-												if(p[pixel[15]] > cb) {
-												}
-												else if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb)
-															if(p[pixel[9]] > cb)
-																if(p[pixel[10]] > cb)
-																	if(p[pixel[11]] > cb) {
-																	}
-																	else
-																		continue;
+											return false;
+									else
+										return false;
+								else if(p[pixel[14]] < c_b)
+									if(p[pixel[7]] < c_b)
+										if(p[pixel[8]] < c_b)
+											if(p[pixel[9]] < c_b)
+												if(p[pixel[10]] < c_b)
+													if(p[pixel[11]] < c_b)
+														if(p[pixel[12]] < c_b)
+															if(p[pixel[13]] < c_b)
+																if(p[pixel[6]] < c_b) {
+																}
+																else if(p[pixel[15]] < c_b) {
+																}
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[12]] < c_b)
-										if(p[pixel[7]] < c_b)
-											if(p[pixel[8]] < c_b)
-												if(p[pixel[9]] < c_b)
-													if(p[pixel[10]] < c_b)
-														if(p[pixel[11]] < c_b)
-															if(p[pixel[13]] < c_b)
-																if(p[pixel[14]] < c_b)
-																	if(p[pixel[6]] < c_b) {
-																	}
-																	else if(p[pixel[15]] < c_b) {
-																	}
-																	else
-																		continue;
-																else
-																	continue;
+											return false;
+									else
+										return false;
+								else if(p[pixel[6]] < c_b)
+									if(p[pixel[7]] < c_b)
+										if(p[pixel[8]] < c_b)
+											if(p[pixel[9]] < c_b)
+												if(p[pixel[10]] < c_b)
+													if(p[pixel[11]] < c_b)
+														if(p[pixel[12]] < c_b)
+															if(p[pixel[13]] < c_b) {
+															}
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
-								else if(p[pixel[4]] < c_b)
-									if(p[pixel[13]] > cb)
-										if(p[pixel[11]] > cb)
-											if(p[pixel[12]] > cb)
-												if(p[pixel[14]] > cb)
-													if(p[pixel[15]] > cb) {
-													}
-													else if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb)
-															if(p[pixel[8]] > cb)
-																if(p[pixel[9]] > cb)
-																	if(p[pixel[10]] > cb) {
-																	}
-																	else
-																		continue;
-																else
-																	continue;
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else if(p[pixel[5]] > cb)
-													if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb)
-															if(p[pixel[8]] > cb)
-																if(p[pixel[9]] > cb)
-																	if(p[pixel[10]] > cb) {
-																	}
-																	else
-																		continue;
-																else
-																	continue;
+										return false;
+								else
+									return false;
+							else if(p[pixel[12]] > cb)
+								if(p[pixel[13]] > cb)
+									if(p[pixel[14]] > cb)
+										if(p[pixel[15]] > cb) {
+										}
+										else if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb)
+												if(p[pixel[8]] > cb)
+													if(p[pixel[9]] > cb)
+														if(p[pixel[10]] > cb)
+															if(p[pixel[11]] > cb) {
+															}
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[11]] < c_b)
-											if(p[pixel[5]] < c_b)
-												if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b)
-															if(p[pixel[9]] < c_b)
-																if(p[pixel[10]] < c_b)
-																	if(p[pixel[12]] < c_b) {
-																	}
-																	else
-																		continue;
-																else
-																	continue;
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else if(p[pixel[12]] < c_b)
+								if(p[pixel[7]] < c_b)
+									if(p[pixel[8]] < c_b)
+										if(p[pixel[9]] < c_b)
+											if(p[pixel[10]] < c_b)
+												if(p[pixel[11]] < c_b)
+													if(p[pixel[13]] < c_b)
+														if(p[pixel[14]] < c_b)
+															if(p[pixel[6]] < c_b) {
+															}
+															else if(p[pixel[15]] < c_b) {
+															}
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[13]] < c_b)
-										if(p[pixel[7]] < c_b)
-											if(p[pixel[8]] < c_b)
-												if(p[pixel[9]] < c_b)
-													if(p[pixel[10]] < c_b)
-														if(p[pixel[11]] < c_b)
-															if(p[pixel[12]] < c_b)
-																if(p[pixel[6]] < c_b)
-																	if(p[pixel[5]] < c_b) {
-																	}
-																	else if(p[pixel[14]] < c_b) {
-																	}
-																	else
-																		continue;
-																else if(p[pixel[14]] < c_b)
-																	if(p[pixel[15]] < c_b) {
-																	}
-																	else
-																		continue;
-																else
-																	continue;
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else if(p[pixel[4]] < c_b)
+							if(p[pixel[13]] > cb)
+								if(p[pixel[11]] > cb)
+									if(p[pixel[12]] > cb)
+										if(p[pixel[14]] > cb)
+											if(p[pixel[15]] > cb) {
+											}
+											else if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb)
+													if(p[pixel[8]] > cb)
+														if(p[pixel[9]] > cb)
+															if(p[pixel[10]] > cb) {
+															}
+															else
+																return false;
+														else
+															return false;
+													else
+														return false;
+												else
+													return false;
+											else
+												return false;
+										else if(p[pixel[5]] > cb)
+											if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb)
+													if(p[pixel[8]] > cb)
+														if(p[pixel[9]] > cb)
+															if(p[pixel[10]] > cb) {
+															}
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[5]] < c_b)
+											return false;
+									else
+										return false;
+								else if(p[pixel[11]] < c_b)
+									if(p[pixel[5]] < c_b)
 										if(p[pixel[6]] < c_b)
 											if(p[pixel[7]] < c_b)
 												if(p[pixel[8]] < c_b)
 													if(p[pixel[9]] < c_b)
 														if(p[pixel[10]] < c_b)
-															if(p[pixel[11]] < c_b)
-																if(p[pixel[12]] < c_b) {
-																}
-																else
-																	continue;
+															if(p[pixel[12]] < c_b) {
+															}
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
-								else if(p[pixel[11]] > cb)
-									if(p[pixel[12]] > cb)
-										if(p[pixel[13]] > cb)
-											if(p[pixel[14]] > cb)
-												if(p[pixel[15]] > cb) {
-												}
-												else if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb)
-															if(p[pixel[9]] > cb)
-																if(p[pixel[10]] > cb) {
-																}
-																else
-																	continue;
+										return false;
+								else
+									return false;
+							else if(p[pixel[13]] < c_b)
+								if(p[pixel[7]] < c_b)
+									if(p[pixel[8]] < c_b)
+										if(p[pixel[9]] < c_b)
+											if(p[pixel[10]] < c_b)
+												if(p[pixel[11]] < c_b)
+													if(p[pixel[12]] < c_b)
+														if(p[pixel[6]] < c_b)
+															if(p[pixel[5]] < c_b) {
+															}
+															else if(p[pixel[14]] < c_b) {
+															}
 															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[5]] > cb)
-												if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb)
-															if(p[pixel[9]] > cb)
-																if(p[pixel[10]] > cb) {
-																}
-																else
-																	continue;
+																return false;
+														else if(p[pixel[14]] < c_b)
+															if(p[pixel[15]] < c_b) {
+															}
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
-								else if(p[pixel[11]] < c_b)
+										return false;
+								else
+									return false;
+							else if(p[pixel[5]] < c_b)
+								if(p[pixel[6]] < c_b)
 									if(p[pixel[7]] < c_b)
 										if(p[pixel[8]] < c_b)
 											if(p[pixel[9]] < c_b)
 												if(p[pixel[10]] < c_b)
-													if(p[pixel[12]] < c_b)
-														if(p[pixel[13]] < c_b)
-															if(p[pixel[6]] < c_b)
-																if(p[pixel[5]] < c_b) {
-																}
-																else if(p[pixel[14]] < c_b) {
-																}
-																else
-																	continue;
-															else if(p[pixel[14]] < c_b)
-																if(p[pixel[15]] < c_b) {
-																}
-																else
-																	continue;
-															else
-																continue;
+													if(p[pixel[11]] < c_b)
+														if(p[pixel[12]] < c_b) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
-							else if(p[pixel[3]] < c_b)
-								if(p[pixel[10]] > cb)
-									if(p[pixel[11]] > cb)
-										if(p[pixel[12]] > cb)
-											if(p[pixel[13]] > cb)
-												if(p[pixel[14]] > cb)
-													if(p[pixel[15]] > cb) {
-													}
-													else if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb)
-															if(p[pixel[8]] > cb)
-																if(p[pixel[9]] > cb) {
-																}
-																else
-																	continue;
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else if(p[pixel[5]] > cb)
-													if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb)
-															if(p[pixel[8]] > cb)
-																if(p[pixel[9]] > cb) {
-																}
-																else
-																	continue;
-															else
-																continue;
+									return false;
+							else
+								return false;
+						else if(p[pixel[11]] > cb)
+							if(p[pixel[12]] > cb)
+								if(p[pixel[13]] > cb)
+									if(p[pixel[14]] > cb)
+										if(p[pixel[15]] > cb) {
+										}
+										else if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb)
+												if(p[pixel[8]] > cb)
+													if(p[pixel[9]] > cb)
+														if(p[pixel[10]] > cb) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
-											else if(p[pixel[4]] > cb)
-												if(p[pixel[5]] > cb)
-													if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb)
-															if(p[pixel[8]] > cb)
-																if(p[pixel[9]] > cb) {
-																}
-																else
-																	continue;
-															else
-																continue;
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else if(p[pixel[5]] > cb)
+										if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb)
+												if(p[pixel[8]] > cb)
+													if(p[pixel[9]] > cb)
+														if(p[pixel[10]] > cb) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
-								else if(p[pixel[10]] < c_b)
-									if(p[pixel[7]] < c_b)
-										if(p[pixel[8]] < c_b)
-											if(p[pixel[9]] < c_b)
-												if(p[pixel[11]] < c_b)
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else if(p[pixel[11]] < c_b)
+							if(p[pixel[7]] < c_b)
+								if(p[pixel[8]] < c_b)
+									if(p[pixel[9]] < c_b)
+										if(p[pixel[10]] < c_b)
+											if(p[pixel[12]] < c_b)
+												if(p[pixel[13]] < c_b)
 													if(p[pixel[6]] < c_b)
-														if(p[pixel[5]] < c_b)
-															if(p[pixel[4]] < c_b) {
-															}
-															else if(p[pixel[12]] < c_b)
-																if(p[pixel[13]] < c_b) {
-																}
-																else
-																	continue;
-															else
-																continue;
-														else if(p[pixel[12]] < c_b)
-															if(p[pixel[13]] < c_b)
-																if(p[pixel[14]] < c_b) {
-																}
-																else
-																	continue;
-															else
-																continue;
+														if(p[pixel[5]] < c_b) {
+														}
+														else if(p[pixel[14]] < c_b) {
+														}
 														else
-															continue;
-													else if(p[pixel[12]] < c_b)
-														if(p[pixel[13]] < c_b)
-															if(p[pixel[14]] < c_b)
-																if(p[pixel[15]] < c_b) {
-																}
-																else
-																	continue;
-															else
-																continue;
+															return false;
+													else if(p[pixel[14]] < c_b)
+														if(p[pixel[15]] < c_b) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
-							else if(p[pixel[10]] > cb)
-								if(p[pixel[11]] > cb)
-									if(p[pixel[12]] > cb)
-										if(p[pixel[13]] > cb)
-											if(p[pixel[14]] > cb)
-												if(p[pixel[15]] > cb) {
-												}
-												else if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb)
-															if(p[pixel[9]] > cb) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[5]] > cb)
-												if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb)
-															if(p[pixel[9]] > cb) {
-															}
-															else
-																continue;
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else if(p[pixel[3]] < c_b)
+						if(p[pixel[10]] > cb)
+							if(p[pixel[11]] > cb)
+								if(p[pixel[12]] > cb)
+									if(p[pixel[13]] > cb)
+										if(p[pixel[14]] > cb)
+											if(p[pixel[15]] > cb) {
+											}
+											else if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb)
+													if(p[pixel[8]] > cb)
+														if(p[pixel[9]] > cb) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[4]] > cb)
-											if(p[pixel[5]] > cb)
-												if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb)
-															if(p[pixel[9]] > cb) {
-															}
-															else
-																continue;
+												return false;
+										else if(p[pixel[5]] > cb)
+											if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb)
+													if(p[pixel[8]] > cb)
+														if(p[pixel[9]] > cb) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else
-										continue;
-								else
-									continue;
-							else if(p[pixel[10]] < c_b)
-								if(p[pixel[7]] < c_b)
-									if(p[pixel[8]] < c_b)
-										if(p[pixel[9]] < c_b)
-											if(p[pixel[11]] < c_b)
-												if(p[pixel[12]] < c_b)
-													if(p[pixel[6]] < c_b)
-														if(p[pixel[5]] < c_b)
-															if(p[pixel[4]] < c_b) {
-															}
-															else if(p[pixel[13]] < c_b) {
-															}
-															else
-																continue;
-														else if(p[pixel[13]] < c_b)
-															if(p[pixel[14]] < c_b) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else if(p[pixel[13]] < c_b)
-														if(p[pixel[14]] < c_b)
-															if(p[pixel[15]] < c_b) {
-															}
-															else
-																continue;
+											return false;
+									else if(p[pixel[4]] > cb)
+										if(p[pixel[5]] > cb)
+											if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb)
+													if(p[pixel[8]] > cb)
+														if(p[pixel[9]] > cb) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
-						else if(p[pixel[2]] < c_b)
-							if(p[pixel[9]] > cb)
-								if(p[pixel[10]] > cb)
-									if(p[pixel[11]] > cb)
-										if(p[pixel[12]] > cb)
-											if(p[pixel[13]] > cb)
-												if(p[pixel[14]] > cb)
-													if(p[pixel[15]] > cb) {
+								return false;
+						else if(p[pixel[10]] < c_b)
+							if(p[pixel[7]] < c_b)
+								if(p[pixel[8]] < c_b)
+									if(p[pixel[9]] < c_b)
+										if(p[pixel[11]] < c_b)
+											if(p[pixel[6]] < c_b)
+												if(p[pixel[5]] < c_b)
+													if(p[pixel[4]] < c_b) {
 													}
-													else if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb)
-															if(p[pixel[8]] > cb) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else if(p[pixel[5]] > cb)
-													if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb)
-															if(p[pixel[8]] > cb) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[4]] > cb)
-												if(p[pixel[5]] > cb)
-													if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb)
-															if(p[pixel[8]] > cb) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
-											else
-												continue;
-										else if(p[pixel[3]] > cb)
-											if(p[pixel[4]] > cb)
-												if(p[pixel[5]] > cb)
-													if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb)
-															if(p[pixel[8]] > cb) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
-											else
-												continue;
-										else
-											continue;
-									else
-										continue;
-								else
-									continue;
-							else if(p[pixel[9]] < c_b)
-								if(p[pixel[7]] < c_b)
-									if(p[pixel[8]] < c_b)
-										if(p[pixel[10]] < c_b)
-											if(p[pixel[6]] < c_b)
-												if(p[pixel[5]] < c_b)
-													if(p[pixel[4]] < c_b)
-														if(p[pixel[3]] < c_b) {
+													else if(p[pixel[12]] < c_b)
+														if(p[pixel[13]] < c_b) {
 														}
-														else if(p[pixel[11]] < c_b)
-															if(p[pixel[12]] < c_b) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else if(p[pixel[11]] < c_b)
-														if(p[pixel[12]] < c_b)
-															if(p[pixel[13]] < c_b) {
-															}
-															else
-																continue;
 														else
-															continue;
+															return false;
 													else
-														continue;
-												else if(p[pixel[11]] < c_b)
-													if(p[pixel[12]] < c_b)
-														if(p[pixel[13]] < c_b)
-															if(p[pixel[14]] < c_b) {
-															}
-															else
-																continue;
+														return false;
+												else if(p[pixel[12]] < c_b)
+													if(p[pixel[13]] < c_b)
+														if(p[pixel[14]] < c_b) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
-											else if(p[pixel[11]] < c_b)
-												if(p[pixel[12]] < c_b)
-													if(p[pixel[13]] < c_b)
-														if(p[pixel[14]] < c_b)
-															if(p[pixel[15]] < c_b) {
-															}
-															else
-																continue;
+													return false;
+											else if(p[pixel[12]] < c_b)
+												if(p[pixel[13]] < c_b)
+													if(p[pixel[14]] < c_b)
+														if(p[pixel[15]] < c_b) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
-						else if(p[pixel[9]] > cb)
-							if(p[pixel[10]] > cb)
-								if(p[pixel[11]] > cb)
-									if(p[pixel[12]] > cb)
-										if(p[pixel[13]] > cb)
-											if(p[pixel[14]] > cb)
-												if(p[pixel[15]] > cb) {
-												}
-												else if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb) {
-														}
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[5]] > cb)
-												if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb) {
-														}
-														else
-															continue;
+								return false;
+						else
+							return false;
+					else if(p[pixel[10]] > cb)
+						if(p[pixel[11]] > cb)
+							if(p[pixel[12]] > cb)
+								if(p[pixel[13]] > cb)
+									if(p[pixel[14]] > cb)
+										if(p[pixel[15]] > cb) {
+										}
+										else if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb)
+												if(p[pixel[8]] > cb)
+													if(p[pixel[9]] > cb) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[4]] > cb)
-											if(p[pixel[5]] > cb)
-												if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb) {
-														}
-														else
-															continue;
+												return false;
+										else
+											return false;
+									else if(p[pixel[5]] > cb)
+										if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb)
+												if(p[pixel[8]] > cb)
+													if(p[pixel[9]] > cb) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[3]] > cb)
-										if(p[pixel[4]] > cb)
-											if(p[pixel[5]] > cb)
-												if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb) {
-														}
-														else
-															continue;
+											return false;
+									else
+										return false;
+								else if(p[pixel[4]] > cb)
+									if(p[pixel[5]] > cb)
+										if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb)
+												if(p[pixel[8]] > cb)
+													if(p[pixel[9]] > cb) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
-						else if(p[pixel[9]] < c_b)
-							if(p[pixel[7]] < c_b)
-								if(p[pixel[8]] < c_b)
-									if(p[pixel[10]] < c_b)
-										if(p[pixel[11]] < c_b)
+								return false;
+						else
+							return false;
+					else if(p[pixel[10]] < c_b)
+						if(p[pixel[7]] < c_b)
+							if(p[pixel[8]] < c_b)
+								if(p[pixel[9]] < c_b)
+									if(p[pixel[11]] < c_b)
+										if(p[pixel[12]] < c_b)
 											if(p[pixel[6]] < c_b)
 												if(p[pixel[5]] < c_b)
-													if(p[pixel[4]] < c_b)
-														if(p[pixel[3]] < c_b) {
-														}
-														else if(p[pixel[12]] < c_b) {
-														}
-														else
-															continue;
-													else if(p[pixel[12]] < c_b)
-														if(p[pixel[13]] < c_b) {
-														}
-														else
-															continue;
+													if(p[pixel[4]] < c_b) {
+													}
+													else if(p[pixel[13]] < c_b) {
+													}
 													else
-														continue;
-												else if(p[pixel[12]] < c_b)
-													if(p[pixel[13]] < c_b)
-														if(p[pixel[14]] < c_b) {
-														}
-														else
-															continue;
+														return false;
+												else if(p[pixel[13]] < c_b)
+													if(p[pixel[14]] < c_b) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
-											else if(p[pixel[12]] < c_b)
-												if(p[pixel[13]] < c_b)
-													if(p[pixel[14]] < c_b)
-														if(p[pixel[15]] < c_b) {
-														}
-														else
-															continue;
+													return false;
+											else if(p[pixel[13]] < c_b)
+												if(p[pixel[14]] < c_b)
+													if(p[pixel[15]] < c_b) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
+								return false;
 						else
-							continue;
-					else if(p[pixel[1]] < c_b)
-						if(p[pixel[8]] > cb)
-							if(p[pixel[9]] > cb)
-								if(p[pixel[10]] > cb)
-									if(p[pixel[11]] > cb)
-										if(p[pixel[12]] > cb)
-											if(p[pixel[13]] > cb)
-												if(p[pixel[14]] > cb)
-													if(p[pixel[15]] > cb) {
+							return false;
+					else
+						return false;
+				else if(p[pixel[2]] < c_b)
+					if(p[pixel[9]] > cb)
+						if(p[pixel[10]] > cb)
+							if(p[pixel[11]] > cb)
+								if(p[pixel[12]] > cb)
+									if(p[pixel[13]] > cb)
+										if(p[pixel[14]] > cb)
+											if(p[pixel[15]] > cb) {
+											}
+											else if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb)
+													if(p[pixel[8]] > cb) {
 													}
-													else if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb) {
-														}
-														else
-															continue;
-													else
-														continue;
-												else if(p[pixel[5]] > cb)
-													if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb) {
-														}
-														else
-															continue;
 													else
-														continue;
+														return false;
 												else
-													continue;
-											else if(p[pixel[4]] > cb)
-												if(p[pixel[5]] > cb)
-													if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb) {
-														}
-														else
-															continue;
+													return false;
+											else
+												return false;
+										else if(p[pixel[5]] > cb)
+											if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb)
+													if(p[pixel[8]] > cb) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[3]] > cb)
-											if(p[pixel[4]] > cb)
-												if(p[pixel[5]] > cb)
-													if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb) {
-														}
-														else
-															continue;
+												return false;
+										else
+											return false;
+									else if(p[pixel[4]] > cb)
+										if(p[pixel[5]] > cb)
+											if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb)
+													if(p[pixel[8]] > cb) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[2]] > cb)
-										if(p[pixel[3]] > cb)
-											if(p[pixel[4]] > cb)
-												if(p[pixel[5]] > cb)
-													if(p[pixel[6]] > cb)
-														if(p[pixel[7]] > cb) {
-														}
-														else
-															continue;
+											return false;
+									else
+										return false;
+								else if(p[pixel[3]] > cb)
+									if(p[pixel[4]] > cb)
+										if(p[pixel[5]] > cb)
+											if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb)
+													if(p[pixel[8]] > cb) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
-						else if(p[pixel[8]] < c_b)
-							if(p[pixel[7]] < c_b)
-								if(p[pixel[9]] < c_b)
+								return false;
+						else
+							return false;
+					else if(p[pixel[9]] < c_b)
+						if(p[pixel[7]] < c_b)
+							if(p[pixel[8]] < c_b)
+								if(p[pixel[10]] < c_b)
 									if(p[pixel[6]] < c_b)
 										if(p[pixel[5]] < c_b)
 											if(p[pixel[4]] < c_b)
-												if(p[pixel[3]] < c_b)
-													if(p[pixel[2]] < c_b) {
+												if(p[pixel[3]] < c_b) {
+												}
+												else if(p[pixel[11]] < c_b)
+													if(p[pixel[12]] < c_b) {
 													}
-													else if(p[pixel[10]] < c_b)
-														if(p[pixel[11]] < c_b) {
-														}
-														else
-															continue;
-													else
-														continue;
-												else if(p[pixel[10]] < c_b)
-													if(p[pixel[11]] < c_b)
-														if(p[pixel[12]] < c_b) {
-														}
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[10]] < c_b)
-												if(p[pixel[11]] < c_b)
-													if(p[pixel[12]] < c_b)
-														if(p[pixel[13]] < c_b) {
-														}
-														else
-															continue;
 													else
-														continue;
+														return false;
 												else
-													continue;
-											else
-												continue;
-										else if(p[pixel[10]] < c_b)
-											if(p[pixel[11]] < c_b)
+													return false;
+											else if(p[pixel[11]] < c_b)
 												if(p[pixel[12]] < c_b)
-													if(p[pixel[13]] < c_b)
-														if(p[pixel[14]] < c_b) {
-														}
-														else
-															continue;
+													if(p[pixel[13]] < c_b) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else
-											continue;
-									else if(p[pixel[10]] < c_b)
-										if(p[pixel[11]] < c_b)
+												return false;
+										else if(p[pixel[11]] < c_b)
 											if(p[pixel[12]] < c_b)
 												if(p[pixel[13]] < c_b)
-													if(p[pixel[14]] < c_b)
-														if(p[pixel[15]] < c_b) {
-														}
-														else
-															continue;
+													if(p[pixel[14]] < c_b) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else
-										continue;
-								else
-									continue;
-							else
-								continue;
-						else
-							continue;
-					else if(p[pixel[8]] > cb)
-						if(p[pixel[9]] > cb)
-							if(p[pixel[10]] > cb)
-								if(p[pixel[11]] > cb)
-									if(p[pixel[12]] > cb)
-										if(p[pixel[13]] > cb)
-											if(p[pixel[14]] > cb)
-												if(p[pixel[15]] > cb) {
-												}
-												else if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb) {
+											return false;
+									else if(p[pixel[11]] < c_b)
+										if(p[pixel[12]] < c_b)
+											if(p[pixel[13]] < c_b)
+												if(p[pixel[14]] < c_b)
+													if(p[pixel[15]] < c_b) {
 													}
 													else
-														continue;
+														return false;
 												else
-													continue;
-											else if(p[pixel[5]] > cb)
-												if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb) {
-													}
-													else
-														continue;
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else
+						return false;
+				else if(p[pixel[9]] > cb)
+					if(p[pixel[10]] > cb)
+						if(p[pixel[11]] > cb)
+							if(p[pixel[12]] > cb)
+								if(p[pixel[13]] > cb)
+									if(p[pixel[14]] > cb)
+										if(p[pixel[15]] > cb) {
+										}
+										else if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb)
+												if(p[pixel[8]] > cb) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[4]] > cb)
-											if(p[pixel[5]] > cb)
-												if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb) {
-													}
-													else
-														continue;
+												return false;
+										else
+											return false;
+									else if(p[pixel[5]] > cb)
+										if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb)
+												if(p[pixel[8]] > cb) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[3]] > cb)
-										if(p[pixel[4]] > cb)
-											if(p[pixel[5]] > cb)
-												if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb) {
-													}
-													else
-														continue;
+											return false;
+									else
+										return false;
+								else if(p[pixel[4]] > cb)
+									if(p[pixel[5]] > cb)
+										if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb)
+												if(p[pixel[8]] > cb) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
-								else if(p[pixel[2]] > cb)
-									if(p[pixel[3]] > cb)
-										if(p[pixel[4]] > cb)
-											if(p[pixel[5]] > cb)
-												if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb) {
-													}
-													else
-														continue;
+										return false;
+								else
+									return false;
+							else if(p[pixel[3]] > cb)
+								if(p[pixel[4]] > cb)
+									if(p[pixel[5]] > cb)
+										if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb)
+												if(p[pixel[8]] > cb) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
+								return false;
 						else
-							continue;
-					else if(p[pixel[8]] < c_b)
-						if(p[pixel[7]] < c_b)
-							if(p[pixel[9]] < c_b)
-								if(p[pixel[10]] < c_b)
+							return false;
+					else
+						return false;
+				else if(p[pixel[9]] < c_b)
+					if(p[pixel[7]] < c_b)
+						if(p[pixel[8]] < c_b)
+							if(p[pixel[10]] < c_b)
+								if(p[pixel[11]] < c_b)
 									if(p[pixel[6]] < c_b)
 										if(p[pixel[5]] < c_b)
 											if(p[pixel[4]] < c_b)
-												if(p[pixel[3]] < c_b)
-													if(p[pixel[2]] < c_b) {
-													}
-													else if(p[pixel[11]] < c_b) {
-													}
-													else
-														continue;
-												else if(p[pixel[11]] < c_b)
-													if(p[pixel[12]] < c_b) {
-													}
-													else
-														continue;
+												if(p[pixel[3]] < c_b) {
+												}
+												else if(p[pixel[12]] < c_b) {
+												}
 												else
-													continue;
-											else if(p[pixel[11]] < c_b)
-												if(p[pixel[12]] < c_b)
-													if(p[pixel[13]] < c_b) {
-													}
-													else
-														continue;
+													return false;
+											else if(p[pixel[12]] < c_b)
+												if(p[pixel[13]] < c_b) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[11]] < c_b)
-											if(p[pixel[12]] < c_b)
-												if(p[pixel[13]] < c_b)
-													if(p[pixel[14]] < c_b) {
-													}
-													else
-														continue;
+												return false;
+										else if(p[pixel[12]] < c_b)
+											if(p[pixel[13]] < c_b)
+												if(p[pixel[14]] < c_b) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[11]] < c_b)
-										if(p[pixel[12]] < c_b)
-											if(p[pixel[13]] < c_b)
-												if(p[pixel[14]] < c_b)
-													if(p[pixel[15]] < c_b) {
-													}
-													else
-														continue;
+											return false;
+									else if(p[pixel[12]] < c_b)
+										if(p[pixel[13]] < c_b)
+											if(p[pixel[14]] < c_b)
+												if(p[pixel[15]] < c_b) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
+								return false;
 						else
-							continue;
+							return false;
 					else
-						continue;
-				else if(p[pixel[0]] < c_b)
-					if(p[pixel[1]] > cb)
-						if(p[pixel[8]] > cb)
-							if(p[pixel[7]] > cb)
-								if(p[pixel[9]] > cb)
-									if(p[pixel[6]] > cb)
-										if(p[pixel[5]] > cb)
-											if(p[pixel[4]] > cb)
-												if(p[pixel[3]] > cb)
-													if(p[pixel[2]] > cb) {
-													}
-													else if(p[pixel[10]] > cb)
-														if(p[pixel[11]] > cb) {
-														}
-														else
-															continue;
-													else
-														continue;
-												else if(p[pixel[10]] > cb)
-													if(p[pixel[11]] > cb)
-														if(p[pixel[12]] > cb) {
-														}
-														else
-															continue;
-													else
-														continue;
+						return false;
+				else
+					return false;
+			else if(p[pixel[1]] < c_b)
+				if(p[pixel[8]] > cb)
+					if(p[pixel[9]] > cb)
+						if(p[pixel[10]] > cb)
+							if(p[pixel[11]] > cb)
+								if(p[pixel[12]] > cb)
+									if(p[pixel[13]] > cb)
+										if(p[pixel[14]] > cb)
+											if(p[pixel[15]] > cb) {
+											}
+											else if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb) {
+												}
 												else
-													continue;
-											else if(p[pixel[10]] > cb)
-												if(p[pixel[11]] > cb)
-													if(p[pixel[12]] > cb)
-														if(p[pixel[13]] > cb) {
-														}
-														else
-															continue;
-													else
-														continue;
+													return false;
+											else
+												return false;
+										else if(p[pixel[5]] > cb)
+											if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[10]] > cb)
-											if(p[pixel[11]] > cb)
-												if(p[pixel[12]] > cb)
-													if(p[pixel[13]] > cb)
-														if(p[pixel[14]] > cb) {
-														}
-														else
-															continue;
-													else
-														continue;
+												return false;
+										else
+											return false;
+									else if(p[pixel[4]] > cb)
+										if(p[pixel[5]] > cb)
+											if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[10]] > cb)
-										if(p[pixel[11]] > cb)
-											if(p[pixel[12]] > cb)
-												if(p[pixel[13]] > cb)
-													if(p[pixel[14]] > cb)
-														if(p[pixel[15]] > cb) {
-														}
-														else
-															continue;
-													else
-														continue;
+											return false;
+									else
+										return false;
+								else if(p[pixel[3]] > cb)
+									if(p[pixel[4]] > cb)
+										if(p[pixel[5]] > cb)
+											if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else if(p[pixel[2]] > cb)
+								if(p[pixel[3]] > cb)
+									if(p[pixel[4]] > cb)
+										if(p[pixel[5]] > cb)
+											if(p[pixel[6]] > cb)
+												if(p[pixel[7]] > cb) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
-						else if(p[pixel[8]] < c_b)
-							if(p[pixel[9]] < c_b)
-								if(p[pixel[10]] < c_b)
-									if(p[pixel[11]] < c_b)
-										if(p[pixel[12]] < c_b)
-											if(p[pixel[13]] < c_b)
-												if(p[pixel[14]] < c_b)
-													if(p[pixel[15]] < c_b) {
-													}
-													else if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b) {
-														}
-														else
-															continue;
-													else
-														continue;
-												else if(p[pixel[5]] < c_b)
-													if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b) {
-														}
-														else
-															continue;
-													else
-														continue;
+								return false;
+						else
+							return false;
+					else
+						return false;
+				else if(p[pixel[8]] < c_b)
+					if(p[pixel[7]] < c_b)
+						if(p[pixel[9]] < c_b)
+							if(p[pixel[6]] < c_b)
+								if(p[pixel[5]] < c_b)
+									if(p[pixel[4]] < c_b)
+										if(p[pixel[3]] < c_b)
+											if(p[pixel[2]] < c_b) {
+											}
+											else if(p[pixel[10]] < c_b)
+												if(p[pixel[11]] < c_b) {
+												}
 												else
-													continue;
-											else if(p[pixel[4]] < c_b)
-												if(p[pixel[5]] < c_b)
-													if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b) {
-														}
-														else
-															continue;
-													else
-														continue;
+													return false;
+											else
+												return false;
+										else if(p[pixel[10]] < c_b)
+											if(p[pixel[11]] < c_b)
+												if(p[pixel[12]] < c_b) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[3]] < c_b)
-											if(p[pixel[4]] < c_b)
-												if(p[pixel[5]] < c_b)
-													if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b) {
-														}
-														else
-															continue;
-													else
-														continue;
+												return false;
+										else
+											return false;
+									else if(p[pixel[10]] < c_b)
+										if(p[pixel[11]] < c_b)
+											if(p[pixel[12]] < c_b)
+												if(p[pixel[13]] < c_b) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[2]] < c_b)
-										if(p[pixel[3]] < c_b)
-											if(p[pixel[4]] < c_b)
-												if(p[pixel[5]] < c_b)
-													if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b) {
-														}
-														else
-															continue;
-													else
-														continue;
+											return false;
+									else
+										return false;
+								else if(p[pixel[10]] < c_b)
+									if(p[pixel[11]] < c_b)
+										if(p[pixel[12]] < c_b)
+											if(p[pixel[13]] < c_b)
+												if(p[pixel[14]] < c_b) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
-							else
-								continue;
+									return false;
+							else if(p[pixel[10]] < c_b)
+								if(p[pixel[11]] < c_b)
+									if(p[pixel[12]] < c_b)
+										if(p[pixel[13]] < c_b)
+											if(p[pixel[14]] < c_b)
+												if(p[pixel[15]] < c_b) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
 						else
-							continue;
-					else if(p[pixel[1]] < c_b)
-						if(p[pixel[2]] > cb)
-							if(p[pixel[9]] > cb)
-								if(p[pixel[7]] > cb)
-									if(p[pixel[8]] > cb)
-										if(p[pixel[10]] > cb)
-											if(p[pixel[6]] > cb)
-												if(p[pixel[5]] > cb)
-													if(p[pixel[4]] > cb)
-														if(p[pixel[3]] > cb) {
-														}
-														else if(p[pixel[11]] > cb)
-															if(p[pixel[12]] > cb) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else if(p[pixel[11]] > cb)
-														if(p[pixel[12]] > cb)
-															if(p[pixel[13]] > cb) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
+							return false;
+					else
+						return false;
+				else
+					return false;
+			else if(p[pixel[8]] > cb)
+				if(p[pixel[9]] > cb)
+					if(p[pixel[10]] > cb)
+						if(p[pixel[11]] > cb)
+							if(p[pixel[12]] > cb)
+								if(p[pixel[13]] > cb)
+									if(p[pixel[14]] > cb)
+										if(p[pixel[15]] > cb) {
+										}
+										else if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else if(p[pixel[5]] > cb)
+										if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[4]] > cb)
+									if(p[pixel[5]] > cb)
+										if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else if(p[pixel[3]] > cb)
+								if(p[pixel[4]] > cb)
+									if(p[pixel[5]] > cb)
+										if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else if(p[pixel[2]] > cb)
+							if(p[pixel[3]] > cb)
+								if(p[pixel[4]] > cb)
+									if(p[pixel[5]] > cb)
+										if(p[pixel[6]] > cb)
+											if(p[pixel[7]] > cb) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else
+						return false;
+				else
+					return false;
+			else if(p[pixel[8]] < c_b)
+				if(p[pixel[7]] < c_b)
+					if(p[pixel[9]] < c_b)
+						if(p[pixel[10]] < c_b)
+							if(p[pixel[6]] < c_b)
+								if(p[pixel[5]] < c_b)
+									if(p[pixel[4]] < c_b)
+										if(p[pixel[3]] < c_b)
+											if(p[pixel[2]] < c_b) {
+											}
+											else if(p[pixel[11]] < c_b) {
+											}
+											else
+												return false;
+										else if(p[pixel[11]] < c_b)
+											if(p[pixel[12]] < c_b) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else if(p[pixel[11]] < c_b)
+										if(p[pixel[12]] < c_b)
+											if(p[pixel[13]] < c_b) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[11]] < c_b)
+									if(p[pixel[12]] < c_b)
+										if(p[pixel[13]] < c_b)
+											if(p[pixel[14]] < c_b) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else if(p[pixel[11]] < c_b)
+								if(p[pixel[12]] < c_b)
+									if(p[pixel[13]] < c_b)
+										if(p[pixel[14]] < c_b)
+											if(p[pixel[15]] < c_b) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else
+						return false;
+				else
+					return false;
+			else
+				return false;
+		else if(p[pixel[0]] < c_b)
+			if(p[pixel[1]] > cb)
+				if(p[pixel[8]] > cb)
+					if(p[pixel[7]] > cb)
+						if(p[pixel[9]] > cb)
+							if(p[pixel[6]] > cb)
+								if(p[pixel[5]] > cb)
+									if(p[pixel[4]] > cb)
+										if(p[pixel[3]] > cb)
+											if(p[pixel[2]] > cb) {
+											}
+											else if(p[pixel[10]] > cb)
+												if(p[pixel[11]] > cb) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else if(p[pixel[10]] > cb)
+											if(p[pixel[11]] > cb)
+												if(p[pixel[12]] > cb) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else if(p[pixel[10]] > cb)
+										if(p[pixel[11]] > cb)
+											if(p[pixel[12]] > cb)
+												if(p[pixel[13]] > cb) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[10]] > cb)
+									if(p[pixel[11]] > cb)
+										if(p[pixel[12]] > cb)
+											if(p[pixel[13]] > cb)
+												if(p[pixel[14]] > cb) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else if(p[pixel[10]] > cb)
+								if(p[pixel[11]] > cb)
+									if(p[pixel[12]] > cb)
+										if(p[pixel[13]] > cb)
+											if(p[pixel[14]] > cb)
+												if(p[pixel[15]] > cb) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else
+						return false;
+				else if(p[pixel[8]] < c_b)
+					if(p[pixel[9]] < c_b)
+						if(p[pixel[10]] < c_b)
+							if(p[pixel[11]] < c_b)
+								if(p[pixel[12]] < c_b)
+									if(p[pixel[13]] < c_b)
+										if(p[pixel[14]] < c_b)
+											if(p[pixel[15]] < c_b) {
+											}
+											else if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else if(p[pixel[5]] < c_b)
+											if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else if(p[pixel[4]] < c_b)
+										if(p[pixel[5]] < c_b)
+											if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[3]] < c_b)
+									if(p[pixel[4]] < c_b)
+										if(p[pixel[5]] < c_b)
+											if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else if(p[pixel[2]] < c_b)
+								if(p[pixel[3]] < c_b)
+									if(p[pixel[4]] < c_b)
+										if(p[pixel[5]] < c_b)
+											if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else
+						return false;
+				else
+					return false;
+			else if(p[pixel[1]] < c_b)
+				if(p[pixel[2]] > cb)
+					if(p[pixel[9]] > cb)
+						if(p[pixel[7]] > cb)
+							if(p[pixel[8]] > cb)
+								if(p[pixel[10]] > cb)
+									if(p[pixel[6]] > cb)
+										if(p[pixel[5]] > cb)
+											if(p[pixel[4]] > cb)
+												if(p[pixel[3]] > cb) {
+												}
 												else if(p[pixel[11]] > cb)
-													if(p[pixel[12]] > cb)
-														if(p[pixel[13]] > cb)
-															if(p[pixel[14]] > cb) {
-															}
-															else
-																continue;
-														else
-															continue;
+													if(p[pixel[12]] > cb) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else if(p[pixel[11]] > cb)
 												if(p[pixel[12]] > cb)
-													if(p[pixel[13]] > cb)
-														if(p[pixel[14]] > cb)
-															if(p[pixel[15]] > cb) {
-															}
-															else
-																continue;
-														else
-															continue;
+													if(p[pixel[13]] > cb) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
+										else if(p[pixel[11]] > cb)
+											if(p[pixel[12]] > cb)
+												if(p[pixel[13]] > cb)
+													if(p[pixel[14]] > cb) {
+													}
+													else
+														return false;
+												else
+													return false;
+											else
+												return false;
 										else
-											continue;
+											return false;
+									else if(p[pixel[11]] > cb)
+										if(p[pixel[12]] > cb)
+											if(p[pixel[13]] > cb)
+												if(p[pixel[14]] > cb)
+													if(p[pixel[15]] > cb) {
+													}
+													else
+														return false;
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
-							else if(p[pixel[9]] < c_b)
-								if(p[pixel[10]] < c_b)
-									if(p[pixel[11]] < c_b)
-										if(p[pixel[12]] < c_b)
-											if(p[pixel[13]] < c_b)
-												if(p[pixel[14]] < c_b)
-													if(p[pixel[15]] < c_b) {
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else if(p[pixel[9]] < c_b)
+						if(p[pixel[10]] < c_b)
+							if(p[pixel[11]] < c_b)
+								if(p[pixel[12]] < c_b)
+									if(p[pixel[13]] < c_b)
+										if(p[pixel[14]] < c_b)
+											if(p[pixel[15]] < c_b) {
+											}
+											else if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b)
+													if(p[pixel[8]] < c_b) {
 													}
-													else if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b)
-															if(p[pixel[8]] < c_b) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else if(p[pixel[5]] < c_b)
-													if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b)
-															if(p[pixel[8]] < c_b) {
-															}
-															else
-																continue;
-														else
-															continue;
 													else
-														continue;
+														return false;
 												else
-													continue;
-											else if(p[pixel[4]] < c_b)
-												if(p[pixel[5]] < c_b)
-													if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b)
-															if(p[pixel[8]] < c_b) {
-															}
-															else
-																continue;
-														else
-															continue;
+													return false;
+											else
+												return false;
+										else if(p[pixel[5]] < c_b)
+											if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b)
+													if(p[pixel[8]] < c_b) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[3]] < c_b)
-											if(p[pixel[4]] < c_b)
-												if(p[pixel[5]] < c_b)
-													if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b)
-															if(p[pixel[8]] < c_b) {
-															}
-															else
-																continue;
-														else
-															continue;
+												return false;
+										else
+											return false;
+									else if(p[pixel[4]] < c_b)
+										if(p[pixel[5]] < c_b)
+											if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b)
+													if(p[pixel[8]] < c_b) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
-								else
-									continue;
-							else
-								continue;
-						else if(p[pixel[2]] < c_b)
-							if(p[pixel[3]] > cb)
-								if(p[pixel[10]] > cb)
-									if(p[pixel[7]] > cb)
-										if(p[pixel[8]] > cb)
-											if(p[pixel[9]] > cb)
-												if(p[pixel[11]] > cb)
-													if(p[pixel[6]] > cb)
-														if(p[pixel[5]] > cb)
-															if(p[pixel[4]] > cb) {
-															}
-															else if(p[pixel[12]] > cb)
-																if(p[pixel[13]] > cb) {
-																}
-																else
-																	continue;
-															else
-																continue;
-														else if(p[pixel[12]] > cb)
-															if(p[pixel[13]] > cb)
-																if(p[pixel[14]] > cb) {
-																}
-																else
-																	continue;
-															else
-																continue;
-														else
-															continue;
-													else if(p[pixel[12]] > cb)
-														if(p[pixel[13]] > cb)
-															if(p[pixel[14]] > cb)
-																if(p[pixel[15]] > cb) {
-																}
-																else
-																	continue;
-															else
-																continue;
-														else
-															continue;
+										return false;
+								else if(p[pixel[3]] < c_b)
+									if(p[pixel[4]] < c_b)
+										if(p[pixel[5]] < c_b)
+											if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b)
+													if(p[pixel[8]] < c_b) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
-								else if(p[pixel[10]] < c_b)
-									if(p[pixel[11]] < c_b)
-										if(p[pixel[12]] < c_b)
-											if(p[pixel[13]] < c_b)
-												if(p[pixel[14]] < c_b)
-													if(p[pixel[15]] < c_b) {
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else
+						return false;
+				else if(p[pixel[2]] < c_b)
+					if(p[pixel[3]] > cb)
+						if(p[pixel[10]] > cb)
+							if(p[pixel[7]] > cb)
+								if(p[pixel[8]] > cb)
+									if(p[pixel[9]] > cb)
+										if(p[pixel[11]] > cb)
+											if(p[pixel[6]] > cb)
+												if(p[pixel[5]] > cb)
+													if(p[pixel[4]] > cb) {
 													}
-													else if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b)
-															if(p[pixel[8]] < c_b)
-																if(p[pixel[9]] < c_b) {
-																}
-																else
-																	continue;
-															else
-																continue;
+													else if(p[pixel[12]] > cb)
+														if(p[pixel[13]] > cb) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
-												else if(p[pixel[5]] < c_b)
-													if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b)
-															if(p[pixel[8]] < c_b)
-																if(p[pixel[9]] < c_b) {
-																}
-																else
-																	continue;
-															else
-																continue;
+														return false;
+												else if(p[pixel[12]] > cb)
+													if(p[pixel[13]] > cb)
+														if(p[pixel[14]] > cb) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
-											else if(p[pixel[4]] < c_b)
-												if(p[pixel[5]] < c_b)
-													if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b)
-															if(p[pixel[8]] < c_b)
-																if(p[pixel[9]] < c_b) {
-																}
-																else
-																	continue;
-															else
-																continue;
+													return false;
+											else if(p[pixel[12]] > cb)
+												if(p[pixel[13]] > cb)
+													if(p[pixel[14]] > cb)
+														if(p[pixel[15]] > cb) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
-							else if(p[pixel[3]] < c_b)
-								if(p[pixel[4]] > cb)
-									if(p[pixel[13]] > cb)
-										if(p[pixel[7]] > cb)
-											if(p[pixel[8]] > cb)
-												if(p[pixel[9]] > cb)
-													if(p[pixel[10]] > cb)
-														if(p[pixel[11]] > cb)
-															if(p[pixel[12]] > cb)
-																if(p[pixel[6]] > cb)
-																	if(p[pixel[5]] > cb) {
-																	}
-																	else if(p[pixel[14]] > cb) {
-																	}
-																	else
-																		continue;
-																else if(p[pixel[14]] > cb)
-																	if(p[pixel[15]] > cb) {
-																	}
-																	else
-																		continue;
-																else
-																	continue;
-															else
-																continue;
+									return false;
+							else
+								return false;
+						else if(p[pixel[10]] < c_b)
+							if(p[pixel[11]] < c_b)
+								if(p[pixel[12]] < c_b)
+									if(p[pixel[13]] < c_b)
+										if(p[pixel[14]] < c_b)
+											if(p[pixel[15]] < c_b) {
+											}
+											else if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b)
+													if(p[pixel[8]] < c_b)
+														if(p[pixel[9]] < c_b) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else
-											continue;
-									else if(p[pixel[13]] < c_b)
-										if(p[pixel[11]] > cb)
-											if(p[pixel[5]] > cb)
-												if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb)
-															if(p[pixel[9]] > cb)
-																if(p[pixel[10]] > cb)
-																	if(p[pixel[12]] > cb) {
-																	}
-																	else
-																		continue;
-																else
-																	continue;
-															else
-																continue;
+												return false;
+										else if(p[pixel[5]] < c_b)
+											if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b)
+													if(p[pixel[8]] < c_b)
+														if(p[pixel[9]] < c_b) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[11]] < c_b)
-											if(p[pixel[12]] < c_b)
-												if(p[pixel[14]] < c_b)
-													if(p[pixel[15]] < c_b) {
-													}
-													else if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b)
-															if(p[pixel[8]] < c_b)
-																if(p[pixel[9]] < c_b)
-																	if(p[pixel[10]] < c_b) {
-																	}
-																	else
-																		continue;
-																else
-																	continue;
-															else
-																continue;
+												return false;
+										else
+											return false;
+									else if(p[pixel[4]] < c_b)
+										if(p[pixel[5]] < c_b)
+											if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b)
+													if(p[pixel[8]] < c_b)
+														if(p[pixel[9]] < c_b) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
-												else if(p[pixel[5]] < c_b)
-													if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b)
-															if(p[pixel[8]] < c_b)
-																if(p[pixel[9]] < c_b)
-																	if(p[pixel[10]] < c_b) {
-																	}
-																	else
-																		continue;
-																else
-																	continue;
+														return false;
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else if(p[pixel[3]] < c_b)
+						if(p[pixel[4]] > cb)
+							if(p[pixel[13]] > cb)
+								if(p[pixel[7]] > cb)
+									if(p[pixel[8]] > cb)
+										if(p[pixel[9]] > cb)
+											if(p[pixel[10]] > cb)
+												if(p[pixel[11]] > cb)
+													if(p[pixel[12]] > cb)
+														if(p[pixel[6]] > cb)
+															if(p[pixel[5]] > cb) {
+															}
+															else if(p[pixel[14]] > cb) {
+															}
+															else
+																return false;
+														else if(p[pixel[14]] > cb)
+															if(p[pixel[15]] > cb) {
+															}
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[5]] > cb)
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else if(p[pixel[13]] < c_b)
+								if(p[pixel[11]] > cb)
+									if(p[pixel[5]] > cb)
 										if(p[pixel[6]] > cb)
 											if(p[pixel[7]] > cb)
 												if(p[pixel[8]] > cb)
 													if(p[pixel[9]] > cb)
 														if(p[pixel[10]] > cb)
-															if(p[pixel[11]] > cb)
-																if(p[pixel[12]] > cb) {
-																}
-																else
-																	continue;
+															if(p[pixel[12]] > cb) {
+															}
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
-								else if(p[pixel[4]] < c_b)
-									if(p[pixel[5]] > cb)
-										if(p[pixel[14]] > cb)
-											if(p[pixel[7]] > cb)
-												if(p[pixel[8]] > cb)
-													if(p[pixel[9]] > cb)
-														if(p[pixel[10]] > cb)
-															if(p[pixel[11]] > cb)
-																if(p[pixel[12]] > cb)
-																	if(p[pixel[13]] > cb)
-																		if(p[pixel[6]] > cb) {
-																		}
-																		else if(p[pixel[15]] > cb) {
-																		}
-																		else
-																			continue;
-																	else
-																		continue;
-																else
-																	continue;
+										return false;
+								else if(p[pixel[11]] < c_b)
+									if(p[pixel[12]] < c_b)
+										if(p[pixel[14]] < c_b)
+											if(p[pixel[15]] < c_b) {
+											}
+											else if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b)
+													if(p[pixel[8]] < c_b)
+														if(p[pixel[9]] < c_b)
+															if(p[pixel[10]] < c_b) {
+															}
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[14]] < c_b)
-											if(p[pixel[12]] > cb)
-												if(p[pixel[6]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb)
-															if(p[pixel[9]] > cb)
-																if(p[pixel[10]] > cb)
-																	if(p[pixel[11]] > cb)
-																		if(p[pixel[13]] > cb) {
-																		}
-																		else
-																			continue;
-																	else
-																		continue;
-																else
-																	continue;
+												return false;
+										else if(p[pixel[5]] < c_b)
+											if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b)
+													if(p[pixel[8]] < c_b)
+														if(p[pixel[9]] < c_b)
+															if(p[pixel[10]] < c_b) {
+															}
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
-											else if(p[pixel[12]] < c_b)
-												if(p[pixel[13]] < c_b)
-													if(p[pixel[15]] < c_b) {
-													}
-													else if(p[pixel[6]] < c_b)
-														if(p[pixel[7]] < c_b)
-															if(p[pixel[8]] < c_b)
-																if(p[pixel[9]] < c_b)
-																	if(p[pixel[10]] < c_b)
-																		if(p[pixel[11]] < c_b) {
-																		}
-																		else
-																			continue;
-																	else
-																		continue;
-																else
-																	continue;
-															else
-																continue;
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else if(p[pixel[5]] > cb)
+								if(p[pixel[6]] > cb)
+									if(p[pixel[7]] > cb)
+										if(p[pixel[8]] > cb)
+											if(p[pixel[9]] > cb)
+												if(p[pixel[10]] > cb)
+													if(p[pixel[11]] > cb)
+														if(p[pixel[12]] > cb) {
+														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[6]] > cb)
-											if(p[pixel[7]] > cb)
-												if(p[pixel[8]] > cb)
-													if(p[pixel[9]] > cb)
-														if(p[pixel[10]] > cb)
-															if(p[pixel[11]] > cb)
-																if(p[pixel[12]] > cb)
-																	if(p[pixel[13]] > cb) {
-																	}
-																	else
-																		continue;
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else if(p[pixel[4]] < c_b)
+							if(p[pixel[5]] > cb)
+								if(p[pixel[14]] > cb)
+									if(p[pixel[7]] > cb)
+										if(p[pixel[8]] > cb)
+											if(p[pixel[9]] > cb)
+												if(p[pixel[10]] > cb)
+													if(p[pixel[11]] > cb)
+														if(p[pixel[12]] > cb)
+															if(p[pixel[13]] > cb)
+																if(p[pixel[6]] > cb) {
+																}
+																else if(p[pixel[15]] > cb) {
+																}
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[5]] < c_b)
+											return false;
+									else
+										return false;
+								else if(p[pixel[14]] < c_b)
+									if(p[pixel[12]] > cb)
 										if(p[pixel[6]] > cb)
-											if(p[pixel[15]] < c_b)
-												if(p[pixel[13]] > cb)
-													if(p[pixel[7]] > cb)
-														if(p[pixel[8]] > cb)
-															if(p[pixel[9]] > cb)
-																if(p[pixel[10]] > cb)
-																	if(p[pixel[11]] > cb)
-																		if(p[pixel[12]] > cb)
-																			if(p[pixel[14]] > cb) {
-																			}
-																			else
-																				continue;
-																		else
-																			continue;
-																	else
-																		continue;
-																else
-																	continue;
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else if(p[pixel[13]] < c_b)
-													if(p[pixel[14]] < c_b) {
-													}
-													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[7]] > cb)
+											if(p[pixel[7]] > cb)
 												if(p[pixel[8]] > cb)
 													if(p[pixel[9]] > cb)
 														if(p[pixel[10]] > cb)
 															if(p[pixel[11]] > cb)
-																if(p[pixel[12]] > cb)
-																	if(p[pixel[13]] > cb)
-																		if(p[pixel[14]] > cb) {
-																		}
-																		else
-																			continue;
-																	else
-																		continue;
+																if(p[pixel[13]] > cb) {
+																}
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[6]] < c_b)
-											if(p[pixel[7]] > cb)
-												if(p[pixel[14]] > cb)
-													if(p[pixel[8]] > cb)
-														if(p[pixel[9]] > cb)
-															if(p[pixel[10]] > cb)
-																if(p[pixel[11]] > cb)
-																	if(p[pixel[12]] > cb)
-																		if(p[pixel[13]] > cb)
-																			if(p[pixel[15]] > cb) {
-																			}
-																			else
-																				continue;
-																		else
-																			continue;
-																	else
-																		continue;
+												return false;
+										else
+											return false;
+									else if(p[pixel[12]] < c_b)
+										if(p[pixel[13]] < c_b)
+											if(p[pixel[15]] < c_b) {
+											}
+											else if(p[pixel[6]] < c_b)
+												if(p[pixel[7]] < c_b)
+													if(p[pixel[8]] < c_b)
+														if(p[pixel[9]] < c_b)
+															if(p[pixel[10]] < c_b)
+																if(p[pixel[11]] < c_b) {
+																}
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
-												else if(p[pixel[14]] < c_b)
-													if(p[pixel[15]] < c_b) {
-													}
-													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[7]] < c_b)
-												if(p[pixel[8]] < c_b) {
-												}
-												else if(p[pixel[15]] < c_b) {
-												}
+														return false;
 												else
-													continue;
-											else if(p[pixel[14]] < c_b)
-												if(p[pixel[15]] < c_b) {
-												}
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[6]] > cb)
+									if(p[pixel[7]] > cb)
+										if(p[pixel[8]] > cb)
+											if(p[pixel[9]] > cb)
+												if(p[pixel[10]] > cb)
+													if(p[pixel[11]] > cb)
+														if(p[pixel[12]] > cb)
+															if(p[pixel[13]] > cb) {
+															}
+															else
+																return false;
+														else
+															return false;
+													else
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[13]] > cb)
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else if(p[pixel[5]] < c_b)
+								if(p[pixel[6]] > cb)
+									if(p[pixel[15]] < c_b)
+										if(p[pixel[13]] > cb)
 											if(p[pixel[7]] > cb)
 												if(p[pixel[8]] > cb)
 													if(p[pixel[9]] > cb)
 														if(p[pixel[10]] > cb)
 															if(p[pixel[11]] > cb)
 																if(p[pixel[12]] > cb)
-																	if(p[pixel[14]] > cb)
-																		if(p[pixel[15]] > cb) {
-																		}
-																		else
-																			continue;
-																	else
-																		continue;
-																else
-																	continue;
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
-											else
-												continue;
-										else if(p[pixel[13]] < c_b)
-											if(p[pixel[14]] < c_b)
-												if(p[pixel[15]] < c_b) {
-												}
-												else
-													continue;
-											else
-												continue;
-										else
-											continue;
-									else if(p[pixel[12]] > cb)
-										if(p[pixel[7]] > cb)
-											if(p[pixel[8]] > cb)
-												if(p[pixel[9]] > cb)
-													if(p[pixel[10]] > cb)
-														if(p[pixel[11]] > cb)
-															if(p[pixel[13]] > cb)
-																if(p[pixel[14]] > cb)
-																	if(p[pixel[6]] > cb) {
-																	}
-																	else if(p[pixel[15]] > cb) {
+																	if(p[pixel[14]] > cb) {
 																	}
 																	else
-																		continue;
+																		return false;
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else
-											continue;
-									else if(p[pixel[12]] < c_b)
-										if(p[pixel[13]] < c_b)
-											if(p[pixel[14]] < c_b)
-												if(p[pixel[15]] < c_b) {
-												}
-												else if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b)
-															if(p[pixel[9]] < c_b)
-																if(p[pixel[10]] < c_b)
-																	if(p[pixel[11]] < c_b) {
-																	}
-																	else
-																		continue;
-																else
-																	continue;
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
+												return false;
+										else if(p[pixel[13]] < c_b)
+											if(p[pixel[14]] < c_b) {
+											}
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else
-										continue;
-								else if(p[pixel[11]] > cb)
-									if(p[pixel[7]] > cb)
+											return false;
+									else if(p[pixel[7]] > cb)
 										if(p[pixel[8]] > cb)
 											if(p[pixel[9]] > cb)
 												if(p[pixel[10]] > cb)
-													if(p[pixel[12]] > cb)
-														if(p[pixel[13]] > cb)
-															if(p[pixel[6]] > cb)
-																if(p[pixel[5]] > cb) {
-																}
-																else if(p[pixel[14]] > cb) {
-																}
-																else
-																	continue;
-															else if(p[pixel[14]] > cb)
-																if(p[pixel[15]] > cb) {
+													if(p[pixel[11]] > cb)
+														if(p[pixel[12]] > cb)
+															if(p[pixel[13]] > cb)
+																if(p[pixel[14]] > cb) {
 																}
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
-								else if(p[pixel[11]] < c_b)
-									if(p[pixel[12]] < c_b)
-										if(p[pixel[13]] < c_b)
-											if(p[pixel[14]] < c_b)
-												if(p[pixel[15]] < c_b) {
-												}
-												else if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b)
-															if(p[pixel[9]] < c_b)
-																if(p[pixel[10]] < c_b) {
-																}
+										return false;
+								else if(p[pixel[6]] < c_b)
+									if(p[pixel[7]] > cb)
+										if(p[pixel[14]] > cb)
+											if(p[pixel[8]] > cb)
+												if(p[pixel[9]] > cb)
+													if(p[pixel[10]] > cb)
+														if(p[pixel[11]] > cb)
+															if(p[pixel[12]] > cb)
+																if(p[pixel[13]] > cb)
+																	if(p[pixel[15]] > cb) {
+																	}
+																	else
+																		return false;
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[5]] < c_b)
-												if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b)
-															if(p[pixel[9]] < c_b)
-																if(p[pixel[10]] < c_b) {
+														return false;
+												else
+													return false;
+											else
+												return false;
+										else if(p[pixel[14]] < c_b)
+											if(p[pixel[15]] < c_b) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else if(p[pixel[7]] < c_b)
+										if(p[pixel[8]] < c_b) {
+										}
+										else if(p[pixel[15]] < c_b) {
+										}
+										else
+											return false;
+									else if(p[pixel[14]] < c_b)
+										if(p[pixel[15]] < c_b) {
+										}
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[13]] > cb)
+									if(p[pixel[7]] > cb)
+										if(p[pixel[8]] > cb)
+											if(p[pixel[9]] > cb)
+												if(p[pixel[10]] > cb)
+													if(p[pixel[11]] > cb)
+														if(p[pixel[12]] > cb)
+															if(p[pixel[14]] > cb)
+																if(p[pixel[15]] > cb) {
 																}
 																else
-																	continue;
+																	return false;
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[13]] < c_b)
+									if(p[pixel[14]] < c_b)
+										if(p[pixel[15]] < c_b) {
+										}
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
-							else if(p[pixel[10]] > cb)
+									return false;
+							else if(p[pixel[12]] > cb)
 								if(p[pixel[7]] > cb)
 									if(p[pixel[8]] > cb)
 										if(p[pixel[9]] > cb)
-											if(p[pixel[11]] > cb)
-												if(p[pixel[12]] > cb)
-													if(p[pixel[6]] > cb)
-														if(p[pixel[5]] > cb)
-															if(p[pixel[4]] > cb) {
-															}
-															else if(p[pixel[13]] > cb) {
-															}
-															else
-																continue;
-														else if(p[pixel[13]] > cb)
-															if(p[pixel[14]] > cb) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else if(p[pixel[13]] > cb)
+											if(p[pixel[10]] > cb)
+												if(p[pixel[11]] > cb)
+													if(p[pixel[13]] > cb)
 														if(p[pixel[14]] > cb)
-															if(p[pixel[15]] > cb) {
+															if(p[pixel[6]] > cb) {
+															}
+															else if(p[pixel[15]] > cb) {
 															}
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
-							else if(p[pixel[10]] < c_b)
-								if(p[pixel[11]] < c_b)
-									if(p[pixel[12]] < c_b)
-										if(p[pixel[13]] < c_b)
-											if(p[pixel[14]] < c_b)
-												if(p[pixel[15]] < c_b) {
-												}
-												else if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b)
-															if(p[pixel[9]] < c_b) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[5]] < c_b)
-												if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b)
-															if(p[pixel[9]] < c_b) {
-															}
-															else
-																continue;
-														else
-															continue;
-													else
-														continue;
-												else
-													continue;
-											else
-												continue;
-										else if(p[pixel[4]] < c_b)
-											if(p[pixel[5]] < c_b)
-												if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b)
-															if(p[pixel[9]] < c_b) {
+									return false;
+							else if(p[pixel[12]] < c_b)
+								if(p[pixel[13]] < c_b)
+									if(p[pixel[14]] < c_b)
+										if(p[pixel[15]] < c_b) {
+										}
+										else if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b)
+												if(p[pixel[8]] < c_b)
+													if(p[pixel[9]] < c_b)
+														if(p[pixel[10]] < c_b)
+															if(p[pixel[11]] < c_b) {
 															}
 															else
-																continue;
+																return false;
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
-						else if(p[pixel[9]] > cb)
+								return false;
+						else if(p[pixel[11]] > cb)
 							if(p[pixel[7]] > cb)
 								if(p[pixel[8]] > cb)
-									if(p[pixel[10]] > cb)
-										if(p[pixel[11]] > cb)
-											if(p[pixel[6]] > cb)
-												if(p[pixel[5]] > cb)
-													if(p[pixel[4]] > cb)
-														if(p[pixel[3]] > cb) {
+									if(p[pixel[9]] > cb)
+										if(p[pixel[10]] > cb)
+											if(p[pixel[12]] > cb)
+												if(p[pixel[13]] > cb)
+													if(p[pixel[6]] > cb)
+														if(p[pixel[5]] > cb) {
 														}
-														else if(p[pixel[12]] > cb) {
+														else if(p[pixel[14]] > cb) {
 														}
 														else
-															continue;
-													else if(p[pixel[12]] > cb)
-														if(p[pixel[13]] > cb) {
+															return false;
+													else if(p[pixel[14]] > cb)
+														if(p[pixel[15]] > cb) {
 														}
 														else
-															continue;
+															return false;
 													else
-														continue;
-												else if(p[pixel[12]] > cb)
-													if(p[pixel[13]] > cb)
-														if(p[pixel[14]] > cb) {
+														return false;
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else if(p[pixel[11]] < c_b)
+							if(p[pixel[12]] < c_b)
+								if(p[pixel[13]] < c_b)
+									if(p[pixel[14]] < c_b)
+										if(p[pixel[15]] < c_b) {
+										}
+										else if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b)
+												if(p[pixel[8]] < c_b)
+													if(p[pixel[9]] < c_b)
+														if(p[pixel[10]] < c_b) {
 														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
-											else if(p[pixel[12]] > cb)
-												if(p[pixel[13]] > cb)
-													if(p[pixel[14]] > cb)
-														if(p[pixel[15]] > cb) {
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else if(p[pixel[5]] < c_b)
+										if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b)
+												if(p[pixel[8]] < c_b)
+													if(p[pixel[9]] < c_b)
+														if(p[pixel[10]] < c_b) {
 														}
 														else
-															continue;
+															return false;
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
-						else if(p[pixel[9]] < c_b)
-							if(p[pixel[10]] < c_b)
-								if(p[pixel[11]] < c_b)
-									if(p[pixel[12]] < c_b)
-										if(p[pixel[13]] < c_b)
-											if(p[pixel[14]] < c_b)
-												if(p[pixel[15]] < c_b) {
-												}
-												else if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b) {
-														}
-														else
-															continue;
+								return false;
+						else
+							return false;
+					else if(p[pixel[10]] > cb)
+						if(p[pixel[7]] > cb)
+							if(p[pixel[8]] > cb)
+								if(p[pixel[9]] > cb)
+									if(p[pixel[11]] > cb)
+										if(p[pixel[12]] > cb)
+											if(p[pixel[6]] > cb)
+												if(p[pixel[5]] > cb)
+													if(p[pixel[4]] > cb) {
+													}
+													else if(p[pixel[13]] > cb) {
+													}
+													else
+														return false;
+												else if(p[pixel[13]] > cb)
+													if(p[pixel[14]] > cb) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
-											else if(p[pixel[5]] < c_b)
-												if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b) {
-														}
-														else
-															continue;
+													return false;
+											else if(p[pixel[13]] > cb)
+												if(p[pixel[14]] > cb)
+													if(p[pixel[15]] > cb) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
-										else if(p[pixel[4]] < c_b)
-											if(p[pixel[5]] < c_b)
-												if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b) {
-														}
-														else
-															continue;
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else if(p[pixel[10]] < c_b)
+						if(p[pixel[11]] < c_b)
+							if(p[pixel[12]] < c_b)
+								if(p[pixel[13]] < c_b)
+									if(p[pixel[14]] < c_b)
+										if(p[pixel[15]] < c_b) {
+										}
+										else if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b)
+												if(p[pixel[8]] < c_b)
+													if(p[pixel[9]] < c_b) {
+													}
 													else
-														continue;
+														return false;
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[3]] < c_b)
-										if(p[pixel[4]] < c_b)
-											if(p[pixel[5]] < c_b)
-												if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b)
-														if(p[pixel[8]] < c_b) {
-														}
-														else
-															continue;
+											return false;
+									else if(p[pixel[5]] < c_b)
+										if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b)
+												if(p[pixel[8]] < c_b)
+													if(p[pixel[9]] < c_b) {
+													}
+													else
+														return false;
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[4]] < c_b)
+									if(p[pixel[5]] < c_b)
+										if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b)
+												if(p[pixel[8]] < c_b)
+													if(p[pixel[9]] < c_b) {
+													}
 													else
-														continue;
+														return false;
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else
+						return false;
+				else if(p[pixel[9]] > cb)
+					if(p[pixel[7]] > cb)
+						if(p[pixel[8]] > cb)
+							if(p[pixel[10]] > cb)
+								if(p[pixel[11]] > cb)
+									if(p[pixel[6]] > cb)
+										if(p[pixel[5]] > cb)
+											if(p[pixel[4]] > cb)
+												if(p[pixel[3]] > cb) {
+												}
+												else if(p[pixel[12]] > cb) {
+												}
+												else
+													return false;
+											else if(p[pixel[12]] > cb)
+												if(p[pixel[13]] > cb) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else if(p[pixel[12]] > cb)
+											if(p[pixel[13]] > cb)
+												if(p[pixel[14]] > cb) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else if(p[pixel[12]] > cb)
+										if(p[pixel[13]] > cb)
+											if(p[pixel[14]] > cb)
+												if(p[pixel[15]] > cb) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else
+						return false;
+				else if(p[pixel[9]] < c_b)
+					if(p[pixel[10]] < c_b)
+						if(p[pixel[11]] < c_b)
+							if(p[pixel[12]] < c_b)
+								if(p[pixel[13]] < c_b)
+									if(p[pixel[14]] < c_b)
+										if(p[pixel[15]] < c_b) {
+										}
+										else if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b)
+												if(p[pixel[8]] < c_b) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else if(p[pixel[5]] < c_b)
+										if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b)
+												if(p[pixel[8]] < c_b) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[4]] < c_b)
+									if(p[pixel[5]] < c_b)
+										if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b)
+												if(p[pixel[8]] < c_b) {
+												}
+												else
+													return false;
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else if(p[pixel[3]] < c_b)
+								if(p[pixel[4]] < c_b)
+									if(p[pixel[5]] < c_b)
+										if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b)
+												if(p[pixel[8]] < c_b) {
+												}
 												else
-													continue;
+													return false;
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
+								return false;
 						else
-							continue;
-					else if(p[pixel[8]] > cb)
-						if(p[pixel[7]] > cb)
-							if(p[pixel[9]] > cb)
-								if(p[pixel[10]] > cb)
-									if(p[pixel[6]] > cb)
-										if(p[pixel[5]] > cb)
-											if(p[pixel[4]] > cb)
-												if(p[pixel[3]] > cb)
-													if(p[pixel[2]] > cb) {
-													}
-													else if(p[pixel[11]] > cb) {
-													}
-													else
-														continue;
-												else if(p[pixel[11]] > cb)
-													if(p[pixel[12]] > cb) {
-													}
-													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[11]] > cb)
-												if(p[pixel[12]] > cb)
-													if(p[pixel[13]] > cb) {
-													}
-													else
-														continue;
-												else
-													continue;
+							return false;
+					else
+						return false;
+				else
+					return false;
+			else if(p[pixel[8]] > cb)
+				if(p[pixel[7]] > cb)
+					if(p[pixel[9]] > cb)
+						if(p[pixel[10]] > cb)
+							if(p[pixel[6]] > cb)
+								if(p[pixel[5]] > cb)
+									if(p[pixel[4]] > cb)
+										if(p[pixel[3]] > cb)
+											if(p[pixel[2]] > cb) {
+											}
+											else if(p[pixel[11]] > cb) {
+											}
 											else
-												continue;
+												return false;
 										else if(p[pixel[11]] > cb)
-											if(p[pixel[12]] > cb)
-												if(p[pixel[13]] > cb)
-													if(p[pixel[14]] > cb) {
-													}
-													else
-														continue;
-												else
-													continue;
+											if(p[pixel[12]] > cb) {
+											}
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else if(p[pixel[11]] > cb)
 										if(p[pixel[12]] > cb)
-											if(p[pixel[13]] > cb)
-												if(p[pixel[14]] > cb)
-													if(p[pixel[15]] > cb) {
-													}
-													else
-														continue;
-												else
-													continue;
+											if(p[pixel[13]] > cb) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else if(p[pixel[11]] > cb)
+									if(p[pixel[12]] > cb)
+										if(p[pixel[13]] > cb)
+											if(p[pixel[14]] > cb) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else if(p[pixel[11]] > cb)
+								if(p[pixel[12]] > cb)
+									if(p[pixel[13]] > cb)
+										if(p[pixel[14]] > cb)
+											if(p[pixel[15]] > cb) {
+											}
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
+								return false;
 						else
-							continue;
-					else if(p[pixel[8]] < c_b)
-						if(p[pixel[9]] < c_b)
-							if(p[pixel[10]] < c_b)
-								if(p[pixel[11]] < c_b)
-									if(p[pixel[12]] < c_b)
-										if(p[pixel[13]] < c_b)
-											if(p[pixel[14]] < c_b)
-												if(p[pixel[15]] < c_b) {
-												}
-												else if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b) {
-													}
-													else
-														continue;
-												else
-													continue;
-											else if(p[pixel[5]] < c_b)
-												if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b) {
-													}
-													else
-														continue;
-												else
-													continue;
+							return false;
+					else
+						return false;
+				else
+					return false;
+			else if(p[pixel[8]] < c_b)
+				if(p[pixel[9]] < c_b)
+					if(p[pixel[10]] < c_b)
+						if(p[pixel[11]] < c_b)
+							if(p[pixel[12]] < c_b)
+								if(p[pixel[13]] < c_b)
+									if(p[pixel[14]] < c_b)
+										if(p[pixel[15]] < c_b) {
+										}
+										else if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b) {
+											}
 											else
-												continue;
-										else if(p[pixel[4]] < c_b)
-											if(p[pixel[5]] < c_b)
-												if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b) {
-													}
-													else
-														continue;
-												else
-													continue;
+												return false;
+										else
+											return false;
+									else if(p[pixel[5]] < c_b)
+										if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b) {
+											}
 											else
-												continue;
+												return false;
 										else
-											continue;
-									else if(p[pixel[3]] < c_b)
-										if(p[pixel[4]] < c_b)
-											if(p[pixel[5]] < c_b)
-												if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b) {
-													}
-													else
-														continue;
-												else
-													continue;
+											return false;
+									else
+										return false;
+								else if(p[pixel[4]] < c_b)
+									if(p[pixel[5]] < c_b)
+										if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b) {
+											}
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
-								else if(p[pixel[2]] < c_b)
-									if(p[pixel[3]] < c_b)
-										if(p[pixel[4]] < c_b)
-											if(p[pixel[5]] < c_b)
-												if(p[pixel[6]] < c_b)
-													if(p[pixel[7]] < c_b) {
-													}
-													else
-														continue;
-												else
-													continue;
+										return false;
+								else
+									return false;
+							else if(p[pixel[3]] < c_b)
+								if(p[pixel[4]] < c_b)
+									if(p[pixel[5]] < c_b)
+										if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b) {
+											}
+											else
+												return false;
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else if(p[pixel[2]] < c_b)
+							if(p[pixel[3]] < c_b)
+								if(p[pixel[4]] < c_b)
+									if(p[pixel[5]] < c_b)
+										if(p[pixel[6]] < c_b)
+											if(p[pixel[7]] < c_b) {
+											}
 											else
-												continue;
+												return false;
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
+								return false;
 						else
-							continue;
+							return false;
 					else
-						continue;
-				else if(p[pixel[7]] > cb)
-					if(p[pixel[8]] > cb)
-						if(p[pixel[9]] > cb)
-							if(p[pixel[6]] > cb)
-								if(p[pixel[5]] > cb)
-									if(p[pixel[4]] > cb)
-										if(p[pixel[3]] > cb)
-											if(p[pixel[2]] > cb)
-												if(p[pixel[1]] > cb) {
-												}
-												else if(p[pixel[10]] > cb) {
-												}
-												else
-													continue;
-											else if(p[pixel[10]] > cb)
-												if(p[pixel[11]] > cb) {
-												}
-												else
-													continue;
-											else
-												continue;
-										else if(p[pixel[10]] > cb)
-											if(p[pixel[11]] > cb)
-												if(p[pixel[12]] > cb) {
-												}
-												else
-													continue;
-											else
-												continue;
+						return false;
+				else
+					return false;
+			else
+				return false;
+		else if(p[pixel[7]] > cb)
+			if(p[pixel[8]] > cb)
+				if(p[pixel[9]] > cb)
+					if(p[pixel[6]] > cb)
+						if(p[pixel[5]] > cb)
+							if(p[pixel[4]] > cb)
+								if(p[pixel[3]] > cb)
+									if(p[pixel[2]] > cb)
+										if(p[pixel[1]] > cb) {
+										}
+										else if(p[pixel[10]] > cb) {
+										}
 										else
-											continue;
+											return false;
 									else if(p[pixel[10]] > cb)
-										if(p[pixel[11]] > cb)
-											if(p[pixel[12]] > cb)
-												if(p[pixel[13]] > cb) {
-												}
-												else
-													continue;
-											else
-												continue;
+										if(p[pixel[11]] > cb) {
+										}
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else if(p[pixel[10]] > cb)
 									if(p[pixel[11]] > cb)
-										if(p[pixel[12]] > cb)
-											if(p[pixel[13]] > cb)
-												if(p[pixel[14]] > cb) {
-												}
-												else
-													continue;
-											else
-												continue;
+										if(p[pixel[12]] > cb) {
+										}
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else if(p[pixel[10]] > cb)
 								if(p[pixel[11]] > cb)
 									if(p[pixel[12]] > cb)
-										if(p[pixel[13]] > cb)
-											if(p[pixel[14]] > cb)
-												if(p[pixel[15]] > cb) {
-												}
-												else
-													continue;
-											else
-												continue;
+										if(p[pixel[13]] > cb) {
+										}
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
+								return false;
+						else if(p[pixel[10]] > cb)
+							if(p[pixel[11]] > cb)
+								if(p[pixel[12]] > cb)
+									if(p[pixel[13]] > cb)
+										if(p[pixel[14]] > cb) {
+										}
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
 						else
-							continue;
+							return false;
+					else if(p[pixel[10]] > cb)
+						if(p[pixel[11]] > cb)
+							if(p[pixel[12]] > cb)
+								if(p[pixel[13]] > cb)
+									if(p[pixel[14]] > cb)
+										if(p[pixel[15]] > cb) {
+										}
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else
+							return false;
 					else
-						continue;
-				else if(p[pixel[7]] < c_b)
-					if(p[pixel[8]] < c_b)
-						if(p[pixel[9]] < c_b)
-							if(p[pixel[6]] < c_b)
-								if(p[pixel[5]] < c_b)
-									if(p[pixel[4]] < c_b)
-										if(p[pixel[3]] < c_b)
-											if(p[pixel[2]] < c_b)
-												if(p[pixel[1]] < c_b) {
-												}
-												else if(p[pixel[10]] < c_b) {
-												}
-												else
-													continue;
-											else if(p[pixel[10]] < c_b)
-												if(p[pixel[11]] < c_b) {
-												}
-												else
-													continue;
-											else
-												continue;
-										else if(p[pixel[10]] < c_b)
-											if(p[pixel[11]] < c_b)
-												if(p[pixel[12]] < c_b) {
-												}
-												else
-													continue;
-											else
-												continue;
+						return false;
+				else
+					return false;
+			else
+				return false;
+		else if(p[pixel[7]] < c_b)
+			if(p[pixel[8]] < c_b)
+				if(p[pixel[9]] < c_b)
+					if(p[pixel[6]] < c_b)
+						if(p[pixel[5]] < c_b)
+							if(p[pixel[4]] < c_b)
+								if(p[pixel[3]] < c_b)
+									if(p[pixel[2]] < c_b)
+										if(p[pixel[1]] < c_b) {
+										}
+										else if(p[pixel[10]] < c_b) {
+										}
 										else
-											continue;
+											return false;
 									else if(p[pixel[10]] < c_b)
-										if(p[pixel[11]] < c_b)
-											if(p[pixel[12]] < c_b)
-												if(p[pixel[13]] < c_b) {
-												}
-												else
-													continue;
-											else
-												continue;
+										if(p[pixel[11]] < c_b) {
+										}
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else if(p[pixel[10]] < c_b)
 									if(p[pixel[11]] < c_b)
-										if(p[pixel[12]] < c_b)
-											if(p[pixel[13]] < c_b)
-												if(p[pixel[14]] < c_b) {
-												}
-												else
-													continue;
-											else
-												continue;
+										if(p[pixel[12]] < c_b) {
+										}
 										else
-											continue;
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else if(p[pixel[10]] < c_b)
 								if(p[pixel[11]] < c_b)
 									if(p[pixel[12]] < c_b)
-										if(p[pixel[13]] < c_b)
-											if(p[pixel[14]] < c_b)
-												if(p[pixel[15]] < c_b) {
-												}
-												else
-													continue;
-											else
-												continue;
+										if(p[pixel[13]] < c_b) {
+										}
+										else
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else if(p[pixel[10]] < c_b)
+							if(p[pixel[11]] < c_b)
+								if(p[pixel[12]] < c_b)
+									if(p[pixel[13]] < c_b)
+										if(p[pixel[14]] < c_b) {
+										}
 										else
-											continue;
+											return false;
+									else
+										return false;
+								else
+									return false;
+							else
+								return false;
+						else
+							return false;
+					else if(p[pixel[10]] < c_b)
+						if(p[pixel[11]] < c_b)
+							if(p[pixel[12]] < c_b)
+								if(p[pixel[13]] < c_b)
+									if(p[pixel[14]] < c_b)
+										if(p[pixel[15]] < c_b) {
+										}
+										else
+											return false;
 									else
-										continue;
+										return false;
 								else
-									continue;
+									return false;
 							else
-								continue;
+								return false;
 						else
-							continue;
+							return false;
 					else
-						continue;
+						return false;
 				else
-					continue;
+					return false;
+			else
+				return false;
+		else
+			return false;
+
+		return true;
+	}
+
+#ifdef __SSE2__
+	// Segment test of the 16 pixels p[0] .. p[15] at once. Returns a mask with
+	// bit i set when p[i] is a corner.
+	static int cornersMask16(const unsigned char* p, const int pixel[], __m128i t) {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i ones = _mm_cmpeq_epi8(zero, zero);
+		const __m128i v = _mm_loadu_si128((const __m128i*) p);
+		const __m128i cb = _mm_adds_epu8(v, t);
+		const __m128i c_b = _mm_subs_epu8(v, t);
+		// not_bright[k] is 0xff where p[pixel[k]] <= cb, not_dark[k] where p[pixel[k]] >= c_b
+		__m128i not_bright[16], not_dark[16];
+		__m128i n_bright = zero, n_dark = zero;
+
+		// 9 contiguous pixels of the circle hold at least 2 of the pixels 0, 4, 8 and 12
+		for(int k = 0; k < 16; k += 4) {
+			const __m128i c = _mm_loadu_si128((const __m128i*)(p + pixel[k]));
+			not_bright[k] = _mm_cmpeq_epi8(_mm_subs_epu8(c, cb), zero);
+			not_dark[k] = _mm_cmpeq_epi8(_mm_subs_epu8(c_b, c), zero);
+			n_bright = _mm_add_epi8(n_bright, not_bright[k]);
+			n_dark = _mm_add_epi8(n_dark, not_dark[k]);
+		}
+		// n_bright and n_dark count down from 0 for each of them which is not bright or dark
+		const __m128i minus_three = _mm_set1_epi8(-3);
+		if(!_mm_movemask_epi8(_mm_or_si128(_mm_cmpgt_epi8(n_bright, minus_three), _mm_cmpgt_epi8(n_dark, minus_three))))
+			return 0;
+
+		for(int k = 0; k < 16; ++k) {
+			if(k % 4 == 0)
+				continue;
+			const __m128i c = _mm_loadu_si128((const __m128i*)(p + pixel[k]));
+			not_bright[k] = _mm_cmpeq_epi8(_mm_subs_epu8(c, cb), zero);
+			not_dark[k] = _mm_cmpeq_epi8(_mm_subs_epu8(c_b, c), zero);
+		}
+
+		// longest run of bright and of dark pixels along the circle, wrapping around
+		__m128i run_bright = zero, run_dark = zero, max_bright = zero, max_dark = zero;
+		for(int k = 0; k < 16 + 8; ++k) {
+			run_bright = _mm_andnot_si128(not_bright[k & 15], _mm_sub_epi8(run_bright, ones));
+			run_dark = _mm_andnot_si128(not_dark[k & 15], _mm_sub_epi8(run_dark, ones));
+			max_bright = _mm_max_epu8(max_bright, run_bright);
+			max_dark = _mm_max_epu8(max_dark, run_dark);
+		}
+		const __m128i eight = _mm_set1_epi8(8);
+		return _mm_movemask_epi8(_mm_or_si128(_mm_cmpgt_epi8(max_bright, eight), _mm_cmpgt_epi8(max_dark, eight)));
+	}
+#endif
+
+	// Appends the corners of the rows y0 .. y1 - 1 to corners, in raster scan order.
+	static void detectRows(const unsigned char* im, int xsize, int y0, int y1, int stride, unsigned char b, std::vector<F9_CORNER>& corners) {
+		int pixel[16];
+		makeOffsets(pixel, stride);
+		F9_CORNER xy;
+#ifdef __SSE2__
+		const __m128i t = _mm_set1_epi8((char) b);
+#endif
 
-				ret_corners.push_back(xy);
+		for(xy.y = y0; xy.y < y1; ++xy.y) {
+			const unsigned char* row = im + xy.y * stride;
+			xy.x = 3;
+#ifdef __SSE2__
+			for(; xy.x + 16 <= xsize - 3; xy.x += 16) {
+				int mask = cornersMask16(row + xy.x, pixel, t);
+				for(int i = 0; mask; ++i, mask >>= 1)
+					if(mask & 1) {
+						F9_CORNER c = { xy.x + i, xy.y };
+						corners.push_back(c);
+					}
 			}
+#endif
+			for(; xy.x < xsize - 3; ++xy.x)
+				if(isCorner(row + xy.x, pixel, b))
+					corners.push_back(xy);
+		}
+	}
+
+	// The rows are split in bands detected in parallel, whose corners are then
+	// concatenated, so the corners stay in raster scan order.
+	void detectAllCorners(const unsigned char* im, int xsize, int ysize, int stride, unsigned char b) {
+		ret_corners.clear();
+		const int rows = ysize - 6;
+		if(rows <= 0)
+			return;
+
+		int threads = 1;
+#ifdef _OPENMP
+		threads = omp_get_max_threads();
+#endif
+		int bands = 4 * threads;
+		if(bands > rows / 32)
+			bands = rows / 32;
+		if(bands < 1)
+			bands = 1;
+		if((int) band_corners.size() < bands)
+			band_corners.resize(bands);
+
+		#pragma omp parallel for schedule(dynamic) if(bands > 1)
+		for(int i = 0; i < bands; ++i) {
+			band_corners[i].clear();
+			detectRows(im, xsize, 3 + (int)((long long) rows * i / bands), 3 + (int)((long long) rows * (i + 1) / bands), stride, b, band_corners[i]);
+		}
+
+		for(int i = 0; i < bands; ++i)
+			ret_corners.insert(ret_corners.end(), band_corners[i].begin(), band_corners[i].end());
 	}
 }; // Impl
 
@@ -5733,7 +5855,8 @@ const std::vector<F9_CORNER>& F9::detectCorners(
     int height,
     int bytes_per_row,
     unsigned char threshold,
-    bool suppress_non_max
+    bool suppress_non_max,
+    bool compute_scores
 ) {
 	return impl->detectCorners(
 	           image_data,
@@ -5741,10 +5864,15 @@ const std::vector<F9_CORNER>& F9::detectCorners(
 	           height,
 	           bytes_per_row,
 	           threshold,
-	           suppress_non_max
+	           suppress_non_max,
+	           compute_scores
 	       );
 }
 
+const std::vector<int>& F9::cornerScores() const {
+	return impl->cornerScores();
+}
+
 // C API
 void* f9_alloc() {
 	return reinterpret_cast<void*>(new F9());
@@ -114,6 +114,7 @@ public:
 	  * @param bytes_per_row Stride of the image.
 	  * @param threshold Threshold below which differences in luminosity are ignored.
 	  * @param suppress_non_max Whether to ignore corners which are neighbors of stronger ones (if true), or be exhaustive (if false).
+	  * @param compute_scores Whether to compute the scores of the corners, see cornerScores. They are always computed when suppress_non_max is true.
 	  * @return A vector of corners.
 	  */
 	const std::vector<F9_CORNER>& detectCorners(
@@ -122,8 +123,15 @@ public:
 	    int height,
 	    int bytes_per_row,
 	    unsigned char threshold,
-	    bool suppress_non_max
+	    bool suppress_non_max,
+	    bool compute_scores = false
 	);
+
+	/** Scores of the corners returned by the last call to detectCorners, in the same order.
+	  * The score of a corner is the highest threshold for which it is still a corner.
+	  * Empty when the scores were not computed.
+	  */
+	const std::vector<int>& cornerScores() const;
 private:
 	F9(const F9&);
 	F9& operator=(const F9&);
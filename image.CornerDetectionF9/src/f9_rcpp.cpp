@@ -1,27 +1,68 @@
 #include <Rcpp.h>
 #include "f9.h"
-#include <iostream>
+#include <vector>
+#include <memory>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 using namespace Rcpp;
 
+// A detector and the buffer in which integer pixel values are converted to bytes.
+// The detector keeps its corner vectors between calls.
+struct f9_context {
+  F9 detector;
+  std::vector<unsigned char> buffer;
+};
+
+// Pixels of an image as bytes. Raw pixels are used in place, integer values are
+// converted in the buffer of the context.
+static const unsigned char *f9_pixels(const unsigned char *raw, const int *values, size_t n, f9_context *ctx) {
+  if(raw)
+    return raw;
+  ctx->buffer.resize(n + 1);
+  for(size_t i = 0; i < n; i++) ctx->buffer[i] = (unsigned char) values[i];
+  return &ctx->buffer[0];
+}
+
+// [[Rcpp::export]]
+SEXP f9_context_new() {
+  XPtr<f9_context> ptr(new f9_context(), true);
+  return ptr;
+}
 
 // [[Rcpp::export]]
-List detect_corners(IntegerVector x, int width, int height, int bytes_per_row, bool suppress_non_max = false, unsigned char threshold = 4) {
-  //unsigned char image_data[x.size()];
-  unsigned char *image_data = new unsigned char[x.size()];
-  for(int i = 0; i < x.size(); i++) image_data[i] = (unsigned char)x[i];
-  const unsigned char * img;
-  img = reinterpret_cast<const unsigned char*>(image_data);
-  F9* f9detector = new F9();
-  //int width = 512;
-  //int height = 512;
-  //int bytes_per_row = 512;
-  //bool suppress_non_max = false;
-  const std::vector<F9_CORNER> out = f9detector -> detectCorners(img,
-                                                                 width,
-                                                                 height,
-                                                                 bytes_per_row,
-                                                                 threshold,
-                                                                 suppress_non_max);
+bool f9_context_valid(SEXP context) {
+  return TYPEOF(context) == EXTPTRSXP && R_ExternalPtrAddr(context) != NULL;
+}
+
+// Corners of an integer or raw vector of pixels with rows of bytes_per_row pixels.
+// Without a context, a detector is allocated for this call only.
+// [[Rcpp::export]]
+List detect_corners(SEXP x, int width, int height, int bytes_per_row, bool suppress_non_max = false, unsigned char threshold = 4, SEXP context = R_NilValue) {
+  if(TYPEOF(x) != INTSXP && TYPEOF(x) != RAWSXP)
+    stop("x should be an integer or raw vector");
+  if(width < 0 || height < 0 || bytes_per_row < width)
+    stop("invalid image size");
+  size_t n = height > 0 ? (size_t) bytes_per_row * (height - 1) + width : 0;
+  if((size_t) Rf_xlength(x) < n)
+    stop("x should contain bytes_per_row * height pixels");
+  std::unique_ptr<f9_context> local;
+  f9_context *ctx;
+  if(context != R_NilValue) {
+    if(!f9_context_valid(context))
+      stop("invalid FAST-9 context");
+    ctx = (f9_context *) R_ExternalPtrAddr(context);
+  } else {
+    local.reset(new f9_context());
+    ctx = local.get();
+  }
+  const unsigned char *img = TYPEOF(x) == RAWSXP ? f9_pixels(RAW(x), NULL, n, ctx) : f9_pixels(NULL, INTEGER(x), n, ctx);
+  const std::vector<F9_CORNER>& out = ctx->detector.detectCorners(img,
+                                                                  width,
+                                                                  height,
+                                                                  bytes_per_row,
+                                                                  threshold,
+                                                                  suppress_non_max);
   int N = out.size();
   NumericVector corners_x(N);
   NumericVector corners_y(N);
@@ -29,7 +70,62 @@ List detect_corners(IntegerVector x, int width, int height, int bytes_per_row, b
     corners_x[i] = out[i].y;
     corners_y[i] = width - out[i].x;
   }
-  delete[] image_data;
   List z = List::create(corners_x, corners_y);
   return z;
 }
+
+// Corners of a sequence of images of the same size, given as an integer or raw vector
+// of width x height x frames pixel values. Every thread has its own detector which it
+// reuses for all the frames it processes. Returns per frame an integer matrix with the
+// x, y location and the score of the corners.
+// [[Rcpp::export]]
+List detect_corners_batch(SEXP x, int width, int height, int frames, bool suppress_non_max = false, unsigned char threshold = 50, int threads = 0) {
+  if(TYPEOF(x) != INTSXP && TYPEOF(x) != RAWSXP)
+    stop("x should be an integer or raw vector");
+  size_t n = (size_t) width * height;
+  if(width < 0 || height < 0 || frames < 0 || (size_t) Rf_xlength(x) != n * frames)
+    stop("x should contain width * height * frames pixels");
+  const int *pixels_int = TYPEOF(x) == INTSXP ? INTEGER(x) : NULL;
+  const unsigned char *pixels_raw = TYPEOF(x) == RAWSXP ? RAW(x) : NULL;
+
+  if(threads < 1) {
+    threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+  }
+  int teams = threads < frames ? threads : frames;
+  if(teams < 1) teams = 1;
+  std::vector<f9_context *> ctx(teams);
+  for(int t = 0; t < teams; t++)
+    ctx[t] = new f9_context();
+  std::vector<std::vector<F9_CORNER> > corners(frames);
+  std::vector<std::vector<int> > scores(frames);
+
+  #pragma omp parallel for schedule(dynamic) num_threads(teams) if(teams > 1)
+  for(int f = 0; f < frames; f++) {
+    int t = 0;
+#ifdef _OPENMP
+    t = omp_get_thread_num();
+#endif
+    const unsigned char *img = f9_pixels(pixels_raw ? pixels_raw + n * f : NULL, pixels_int ? pixels_int + n * f : NULL, n, ctx[t]);
+    corners[f] = ctx[t]->detector.detectCorners(img, width, height, width, threshold, suppress_non_max, true);
+    scores[f] = ctx[t]->detector.cornerScores();
+  }
+  for(int t = 0; t < teams; t++)
+    delete ctx[t];
+
+  List z(frames);
+  for(int f = 0; f < frames; f++) {
+    int N = corners[f].size();
+    IntegerMatrix m(N, 3);
+    for(int i = 0; i < N; i++) {
+      m(i, 0) = corners[f][i].y;
+      m(i, 1) = width - corners[f][i].x;
+      m(i, 2) = scores[f][i];
+    }
+    colnames(m) = CharacterVector::create("x", "y", "score");
+    z[f] = m;
+  }
+  return z;
+}
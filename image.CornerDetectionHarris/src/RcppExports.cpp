@@ -6,7 +6,7 @@
 using namespace Rcpp;
 
 // detect_corners
-SEXP detect_corners(Rcpp::NumericVector x, int nx, int ny, float k, float sigma_d, float sigma_i, float threshold, int gaussian, int gradient, int strategy, int Nselect, int measure, int Nscales, int precision, int cells, int verbose);
+SEXP detect_corners(Rcpp::NumericVector x, int nx, int ny, float k, float sigma_d, Rcpp::NumericVector sigma_i, float threshold, int gaussian, int gradient, int strategy, int Nselect, int measure, int Nscales, int precision, int cells, int verbose);
 RcppExport SEXP _image_CornerDetectionHarris_detect_corners(SEXP xSEXP, SEXP nxSEXP, SEXP nySEXP, SEXP kSEXP, SEXP sigma_dSEXP, SEXP sigma_iSEXP, SEXP thresholdSEXP, SEXP gaussianSEXP, SEXP gradientSEXP, SEXP strategySEXP, SEXP NselectSEXP, SEXP measureSEXP, SEXP NscalesSEXP, SEXP precisionSEXP, SEXP cellsSEXP, SEXP verboseSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
@@ -16,7 +16,7 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< int >::type ny(nySEXP);
     Rcpp::traits::input_parameter< float >::type k(kSEXP);
     Rcpp::traits::input_parameter< float >::type sigma_d(sigma_dSEXP);
-    Rcpp::traits::input_parameter< float >::type sigma_i(sigma_iSEXP);
+    Rcpp::traits::input_parameter< Rcpp::NumericVector >::type sigma_i(sigma_iSEXP);
     Rcpp::traits::input_parameter< float >::type threshold(thresholdSEXP);
     Rcpp::traits::input_parameter< int >::type gaussian(gaussianSEXP);
     Rcpp::traits::input_parameter< int >::type gradient(gradientSEXP);
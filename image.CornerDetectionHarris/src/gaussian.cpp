@@ -281,6 +281,81 @@ void sii_gaussian_conv_image(sii_coeffs &c, float *dest,
 }
 
 
+/**
+ *
+ * Coefficients of the 1D kernel of the separable Gaussian, with size the 
+ * radius of the window plus one
+ *
+ */
+static double *discrete_gaussian_kernel(
+  float sigma, //Gaussian standard deviation
+  int   size   //number of coefficients
+)
+{
+  double den  = 2*sigma*sigma;
+
+  //compute the coefficients of the 1D convolution kernel
+  double *B = new double[size];
+  for (int i=0; i<size; i++)
+    B[i] = 1/(sigma*sqrt(2.0*3.1415926))*exp(-i*i/den);
+
+  double norm=0;
+
+  //normalize the 1D convolution kernel
+  for (int i=0; i<size; i++)
+    norm += B[i];
+
+  norm *= 2;
+
+  norm -= B[0];
+
+  for (int i=0; i<size; i++)
+    B[i] /= norm;
+
+  return B;
+}
+
+
+/**
+ *
+ * Convolution of one line of an image with the separable Gaussian kernel
+ *
+ */
+static void discrete_gaussian_row(
+  const double *B,  //kernel coefficients
+  int   size,       //number of coefficients
+  const float *I,   //input line
+  float *Is,        //output line
+  double *R,        //buffer with space for size+xdim+size values
+  int   xdim        //line length
+)
+{
+  int i;
+  int j;
+  int bdx = xdim+size;
+
+  for (i=size; i<bdx; i++)
+    R[i] = I[i-size];
+
+  //reflecting boundary conditions
+  for (i=0, j=bdx; i<size; i++, j++)
+  {
+    R[i] = I[(size-i<xdim)?size-i:xdim-1];
+    R[j] = I[xdim-i-1];
+  }
+
+  for (i=size; i<bdx; i++)
+  {
+    double sum = B[0]*R[i];
+
+    for (int j = 1; j < size; j++)
+      sum += B[j]*(R[i-j]+R[i+j]);
+
+    Is[i-size] = sum;
+  }
+}
+
+
 /**
  *
  * Convolution with a Gaussian using separable filters
@@ -304,30 +379,12 @@ void discrete_gaussian(
     return;
   }
   
-  double den  = 2*sigma*sigma;
   int    size = (int) (precision*sigma)+1;
-  int    bdx  = xdim+size;
   int    bdy  = ydim+size;
 
   if(size>xdim) return;
         
-  //compute the coefficients of the 1D convolution kernel
-  double *B = new double[size];
-  for (int i=0; i<size; i++)
-    B[i] = 1/(sigma*sqrt(2.0*3.1415926))*exp(-i*i/den);
-
-  double norm=0;
-
-  //normalize the 1D convolution kernel
-  for (int i=0; i<size; i++)
-    norm += B[i];
-
-  norm *= 2;
-
-  norm -= B[0];
-
-  for (int i=0; i<size; i++)
-    B[i] /= norm;
+  double *B = discrete_gaussian_kernel(sigma, size);
 
   #ifdef _OPENMP
   #pragma omp parallel for
@@ -335,28 +392,8 @@ void discrete_gaussian(
   //convolution of each line of the input image
   for (int k=0; k<ydim; k++)
   {
-    int i;
-    int j;
     double *R = new double[size+xdim+size];
-    for (i=size; i<bdx; i++)
-      R[i] = I[k*xdim+i-size];
-
-    //reflecting boundary conditions
-    for (i=0, j=bdx; i<size; i++, j++)
-    {
-      R[i] = I[k*xdim+size-i];
-      R[j] = I[k*xdim+xdim-i-1];
-    }
-
-    for (i=size; i<bdx; i++)
-    {
-      double sum = B[0]*R[i];
-
-      for (int j = 1; j < size; j++)
-        sum += B[j]*(R[i-j]+R[i+j]);
-
-      Is[k*xdim+i-size] = sum;
-    }
+    discrete_gaussian_row(B, size, I+k*xdim, Is+k*xdim, R, xdim);
     delete []R;
   }
 
@@ -375,8 +412,8 @@ void discrete_gaussian(
     //reflecting boundary conditions
     for (i=0, j=bdy; i<size; i++, j++)
     {
-      T[i] = Is[(size-i)*xdim+k];
-      T[j] = Is[(ydim-i-1)*xdim+k];
+      T[i] = Is[((size-i<ydim)?size-i:ydim-1)*xdim+k];
+      T[j] = Is[((ydim-i-1>0)?ydim-i-1:0)*xdim+k];
     }
       
     for (i=size; i<bdy; i++)
@@ -430,3 +467,183 @@ void gaussian(
 }
 
 
+
+
+/**
+ *
+ * Number of rows above a band of rows that are read to convolve it
+ *
+ */
+int gaussian_halo(
+  float sigma, //Gaussian sigma
+  int   type,  //type of Gaussian convolution (fast, standard or none)
+  int   K      //defines the number of iterations or window precision
+)
+{
+  if(type==STD_GAUSSIAN)
+  {
+    if(sigma<=0 || K<=0) return 0;
+    return (int) (K*sigma);
+  }
+  else if(type==FAST_GAUSSIAN)
+  {
+    sii_coeffs c; 
+    sii_precomp(&c, sigma, K);
+    return c.radii[0]+1;
+  }
+  return 0;
+}
+
+
+/**
+ *
+ * Convolution with a Gaussian of the rows y0 to y1-1 of an image with nc 
+ * channels, streaming over the rows. Row y of the channels is requested
+ * from input as nc consecutive lines of nx values, convolved horizontally
+ * and kept in a window of rows which is convolved vertically as soon as
+ * the rows below the output row are read. The convolved rows are handed
+ * over to output in increasing order, such that no image but the input 
+ * is needed. The rows of the band are the same as those of gaussian()
+ * on each channel, except for the fast Gaussian of bands not starting at
+ * the first row, where the integral images start at the band.
+ *
+ */
+void gaussian_band(
+  void  (*input)(void *data, int y, float *rows),  //gives row y of the channels
+  void  (*output)(void *data, int y, float *rows), //takes convolved row y
+  void  *data,  //argument of input and output
+  int   nx,     //image width
+  int   ny,     //image height
+  int   nc,     //number of channels
+  int   y0,     //first row of the band
+  int   y1,     //row after the last row of the band
+  float sigma,  //Gaussian sigma
+  int   type,   //type of Gaussian convolution (fast, standard or none)
+  int   K       //defines the number of iterations or window precision
+)
+{
+  int    width = nc*nx;
+  float *in    = new float[width];
+  float *out   = new float[width];
+
+  if(type==FAST_GAUSSIAN)
+  {
+    //using Stacked Integral Images
+    sii_coeffs c; 
+    sii_precomp(&c, sigma, K);
+    
+    long pad = c.radii[0] + 1;
+    long nr  = 2*pad;
+    float *buffer = new float[sii_buffer_size(c, nx)];
+    float *h      = new float[width];
+    float *accum  = new float[width];
+    float *sums   = new float[nr*width];
+    float *p[SII_MAX_K], *q[SII_MAX_K];
+    int    last   = -1;
+
+    for (int i = 0; i < width; i++) accum[i] = 0;
+
+    //cumulative sums of the columns over n = y0-pad,..., y1+radius-1
+    for (long m = y0 - pad; m < y1 + c.radii[0]; ++m)
+    {
+      int e = extension(ny, m);
+      if (e != last)
+      {
+        input(data, e, in);
+        for (int channel = 0; channel < nc; ++channel)
+          sii_gaussian_conv(c, h + channel*nx, buffer, in + channel*nx, nx, 1);
+        last = e;
+      }
+
+      float *sum = sums + ((m - y0 + pad) % nr) * width;
+      for (int i = 0; i < width; i++)
+      {
+        accum[i] += h[i];
+        sum[i] = accum[i];
+      }
+
+      //stacked box filters of row n
+      long n = m - c.radii[0];
+      if (n >= y0)
+      {
+        for (int k = 0; k < c.K; ++k)
+        {
+          p[k] = sums + ((n + c.radii[k] - y0 + pad) % nr) * width;
+          q[k] = sums + ((n - c.radii[k] - 1 - y0 + pad) % nr) * width;
+        }
+        for (int i = 0; i < width; i++)
+          out[i] = c.weights[0] * (p[0][i] - q[0][i]);
+        for (int k = 1; k < c.K; ++k)
+          for (int i = 0; i < width; i++)
+            out[i] += c.weights[k] * (p[k][i] - q[k][i]);
+
+        output(data, n, out);
+      }
+    }
+
+    delete []buffer;
+    delete []h;
+    delete []accum;
+    delete []sums;
+  }
+  else if(type==STD_GAUSSIAN && sigma>0 && K>0 && (int)(K*sigma)+1<=nx)
+  {
+    //using separable filters
+    int     size = (int) (K*sigma)+1;
+    int     nr   = 2*size-1;
+    double *B    = discrete_gaussian_kernel(sigma, size);
+    double *R    = new double[size+nx+size];
+    float  *rows = new float[nr*width];
+    const float **T = new const float*[nr];
+
+    //horizontal convolutions of the rows y0-size+1,..., y1+size-2
+    for (int m = y0 - size + 1; m < y1 + size - 1; ++m)
+    {
+      //reflecting boundary conditions
+      int e = m;
+      if (e < 0) e = -e;
+      if (e >= ny) e = 2*ny-1-e;
+      if (e < 0) e = 0;
+      if (e >= ny) e = ny-1;
+
+      float *row = rows + ((m - y0 + size - 1) % nr) * width;
+      input(data, e, in);
+      for (int channel = 0; channel < nc; ++channel)
+        discrete_gaussian_row(B, size, in + channel*nx, row + channel*nx, R, nx);
+
+      //vertical convolution of row n
+      int n = m - size + 1;
+      if (n >= y0)
+      {
+        for (int j = 0; j < nr; j++)
+          T[j] = rows + ((n - y0 + j) % nr) * width;
+        for (int i = 0; i < width; i++)
+        {
+          double sum = B[0]*T[size-1][i];
+
+          for (int j = 1; j < size; j++)
+            sum += B[j]*((double)T[size-1-j][i]+(double)T[size-1+j][i]);
+
+          out[i] = sum;
+        }
+        output(data, n, out);
+      }
+    }
+
+    delete []B;
+    delete []R;
+    delete []rows;
+    delete []T;
+  }
+  else
+  {
+    for (int y = y0; y < y1; ++y)
+    {
+      input(data, y, in);
+      output(data, y, in);
+    }
+  }
+
+  delete []in;
+  delete []out;
+}
@@ -31,4 +31,35 @@ void gaussian(
 );
 
 
+/**
+ *
+ * Number of rows above a band of rows that are read to convolve it
+ *
+ */
+int gaussian_halo(
+  float sigma, //Gaussian sigma
+  int   type=FAST_GAUSSIAN, //type of Gaussian convolution 
+  int   K=3    //defines the number of iterations or window precision
+);
+
+/**
+ *
+ * Convolution with a Gaussian of a band of rows of an image with nc 
+ * channels, reading and writing the image row by row
+ *
+ */
+void gaussian_band(
+  void  (*input)(void *data, int y, float *rows),  //gives row y of the channels
+  void  (*output)(void *data, int y, float *rows), //takes convolved row y
+  void  *data,  //argument of input and output
+  int   nx,     //image width
+  int   ny,     //image height
+  int   nc,     //number of channels
+  int   y0,     //first row of the band
+  int   y1,     //row after the last row of the band
+  float sigma,  //Gaussian sigma
+  int   type=FAST_GAUSSIAN, //type of Gaussian convolution 
+  int   K=3     //defines the number of iterations or window precision
+);
+
 #endif
@@ -126,3 +126,54 @@ void gradient(
   else
     central_differences(I, Ix, Iy, nx, ny);
 }
+
+
+/**
+  *
+  * Function to compute the gradient of one row of the image, giving
+  * the same values as row y of gradient()
+  *
+**/
+void gradient_row(
+  float *I,  //input image
+  float *dx, //computed x derivative of the row
+  float *dy, //computed y derivative of the row
+  int   nx,  //image width
+  int   ny,  //image height
+  int   y,   //row of the image
+  int   type //type of gradient
+)
+{
+    //the first and last rows are copies of their neighbours
+    if(y<1) y=1;
+    if(y>ny-2) y=ny-2;
+
+    if(type==SOBEL_OPERATOR)
+    {
+      for(int j=1; j<nx-1; j++)
+      {
+          int p = y*nx+j;
+          dx[j] = 1./4.*(I[p+1]-I[p-1])+
+                  1./8.*(I[p-nx+1]+I[p+nx+1]-
+                         I[p-nx-1]-I[p+nx-1]);
+          dy[j] = 1./4.*(I[p+nx]-I[p-nx])+
+                  1./8.*(I[p+nx+1]+I[p+nx-1]-
+                         I[p-nx+1]-I[p-nx-1]);
+      }
+    }
+    else
+    {
+      for(int j=1; j<nx-1; j++)
+      {
+          int p = y*nx+j;
+          dx[j] = 0.5*(I[p+1]-I[p-1]);
+          dy[j] = 0.5*(I[p+nx]-I[p-nx]);
+      }
+    }
+
+    //copy first and last columns
+    dx[0]=dx[1];
+    dx[nx-1]=dx[nx-2];
+    dy[0]=dy[1];
+    dy[nx-1]=dy[nx-2];
+}
@@ -28,4 +28,19 @@ void gradient(
   int   type //type of gradient
 );
 
+/**
+  *
+  * Function to compute the gradient of one row of the image
+  *
+**/
+void gradient_row(
+  float *I,  //input image
+  float *dx, //computed x derivative of the row
+  float *dy, //computed y derivative of the row
+  int   nx,  //image width
+  int   ny,  //image height
+  int   y,   //row of the image
+  int   type //type of gradient
+);
+
 #endif
@@ -20,6 +20,9 @@
 
 using namespace std;
 
+//minimum number of rows of the bands of the autocorrelation
+#define BAND_ROWS 64
+
 
 /**
   *
@@ -36,40 +39,6 @@ bool operator<(
 }
 
 
-/**
-  *
-  * Function for computing the Autocorrelation matrix
-  *
-**/
-void compute_autocorrelation_matrix(
-  float *Ix,   //gradient of the image
-  float *Iy,   //gradient of the image
-  float *A,    //first coefficient of the autocorrelation matrix: G*(IxIx)
-  float *B,    //symmetric coefficient of the autocorrelation matrix: G*(IxIy)
-  float *C,    //last coefficient of the autocorrelation matrix: G*(IyIy)
-  float sigma, //standard deviation for smoothing 
-  int   nx,    //number of columns of the image
-  int   ny,    //number of rows of the image
-  int   gauss  //type of Gaussian 
-
-)
-{
-  for (int i=0;i<nx*ny;i++)
-  {
-     A[i] = Ix[i]*Ix[i];
-     B[i] = Ix[i]*Iy[i];
-     C[i] = Iy[i]*Iy[i];
-  }
-  
-  if(gauss==NO_GAUSSIAN)
-    gauss=FAST_GAUSSIAN;
-
-  gaussian(A, A, nx, ny, sigma, gauss);
-  gaussian(B, B, nx, ny, sigma, gauss);
-  gaussian(C, C, nx, ny, sigma, gauss);
-} 
-
-
 /**
   *
   * Function for computing Harris' discriminant function
@@ -81,20 +50,14 @@ void compute_corner_response(
   float *C,      //bottom-right coefficient of the Autocorrelation matrix
   float *R,      //corner strength function
   int   measure, //measure strategy
-  int   nx,      //number of columns of the image
-  int   ny,      //number of rows of the image
+  int   size,    //number of values
   float k        //Harris coefficient for the measure function
 )
 {
-  int size = nx*ny;
-  
   //compute the corner strength function following one strategy
   switch(measure) 
   {
     default: case HARRIS_MEASURE:
-      #ifdef _OPENMP
-      #pragma omp parallel for
-      #endif
       for (int i=0; i<size; i++)
       {
         float detA  =A[i]*C[i]-B[i]*B[i];
@@ -105,9 +68,6 @@ void compute_corner_response(
       break;
 
     case SHI_TOMASI_MEASURE:
-      #ifdef _OPENMP
-      #pragma omp parallel for
-      #endif      
       for (int i=0; i<size; i++)
       {
         float D=sqrt(A[i]*A[i]-2*A[i]*C[i]+4*B[i]*B[i]+C[i]*C[i]);
@@ -118,9 +78,6 @@ void compute_corner_response(
       break;
 
     case HARMONIC_MEAN_MEASURE: 
-      #ifdef _OPENMP
-      #pragma omp parallel for
-      #endif      
       for (int i=0; i<size; i++)
       {
         float detA  =A[i]*C[i]-B[i]*B[i];
@@ -133,6 +90,140 @@ void compute_corner_response(
 }
 
 
+/**
+  *
+  * Data of a band of rows for computing the Autocorrelation matrix 
+  * and the corner strength function row by row
+  *
+**/
+struct autocorrelation_band
+{
+  float *I;      //smoothed image
+  float *R;      //corner strength function
+  float *Ix;     //gradient of the current row
+  float *Iy;     //gradient of the current row
+  int   grad;    //type of gradient
+  int   measure; //measure strategy
+  float k;       //Harris coefficient for the measure function
+  int   nx;      //number of columns of the image
+  int   ny;      //number of rows of the image
+};
+
+
+/**
+  *
+  * Coefficients IxIx, IxIy and IyIy of row y of the Autocorrelation matrix
+  *
+**/
+void autocorrelation_row(void *data, int y, float *rows)
+{
+  autocorrelation_band *band=(autocorrelation_band *)data;
+  int   nx=band->nx;
+  float *Ix=band->Ix;
+  float *Iy=band->Iy;
+  float *A=rows, *B=rows+nx, *C=rows+2*nx;
+
+  gradient_row(band->I, Ix, Iy, nx, band->ny, y, band->grad);
+  for (int i=0;i<nx;i++)
+  {
+     A[i] = Ix[i]*Ix[i];
+     B[i] = Ix[i]*Iy[i];
+     C[i] = Iy[i]*Iy[i];
+  }
+}
+
+
+/**
+  *
+  * Corner strength function of row y from the smoothed coefficients
+  *
+**/
+void corner_response_row(void *data, int y, float *rows)
+{
+  autocorrelation_band *band=(autocorrelation_band *)data;
+  int nx=band->nx;
+
+  compute_corner_response(
+    rows, rows+nx, rows+2*nx, band->R+(long)y*nx, band->measure, nx, band->k
+  );
+}
+
+
+/**
+  *
+  * Image and corner strength function of one scale of the pyramid
+  *
+**/
+struct harris_level
+{
+  float *I;      //image at this scale
+  float *R;      //corner strength function
+  int   nx;      //number of columns of the image
+  int   ny;      //number of rows of the image
+  float sigma_i; //standard deviation for smoothing at this scale
+  vector<harris_corner> corners; //corners at this scale
+};
+
+
+/**
+  *
+  * Function for computing the Autocorrelation matrix and the corner
+  * strength function at all the scales in one pass. The gradient, the 
+  * coefficients of the matrix and their convolution are computed row by 
+  * row in bands of rows, such that only the corner strength function is 
+  * stored for the whole image. The bands of all the scales are computed
+  * in parallel together.
+  *
+**/
+void compute_autocorrelation_response(
+  vector<harris_level> &levels, //scales of the image
+  int   grad,    //type of gradient
+  int   gauss,   //type of Gaussian 
+  int   measure, //measure strategy
+  float k        //Harris coefficient for the measure function
+)
+{
+  if(gauss==NO_GAUSSIAN)
+    gauss=FAST_GAUSSIAN;
+
+  //the rows around a band are read twice, keep bands large against them
+  vector<int> band_level, band_y0, band_y1;
+  for(unsigned int l=0; l<levels.size(); l++)
+  {
+    int rows=8*gaussian_halo(levels[l].sigma_i, gauss);
+    if(rows<BAND_ROWS) rows=BAND_ROWS;
+    for(int y=0; y<levels[l].ny; y+=rows)
+    {
+      band_level.push_back(l);
+      band_y0.push_back(y);
+      band_y1.push_back(min(y+rows, levels[l].ny));
+    }
+  }
+  int bands=band_level.size();
+
+  #ifdef _OPENMP
+  #pragma omp parallel for schedule(dynamic)
+  #endif
+  for(int b=0; b<bands; b++)
+  {
+    harris_level &level=levels[band_level[b]];
+    float *Ix=new float[level.nx];
+    float *Iy=new float[level.nx];
+    autocorrelation_band band={
+      level.I, level.R, Ix, Iy, grad, measure, k, level.nx, level.ny
+    };
+
+    gaussian_band(
+      autocorrelation_row, corner_response_row, &band, 
+      level.nx, level.ny, 3, band_y0[b], band_y1[b], level.sigma_i, gauss
+    );
+
+    delete []Ix;
+    delete []Iy;
+  }
+}
+
+
 /**
   *
   * Function for non-maximum suppression
@@ -306,6 +397,9 @@ void select_output_corners(
       }
 
       //sort the corners in each cell
+      #ifdef _OPENMP
+      #pragma omp parallel for schedule(dynamic)
+      #endif
       for(int i=0; i<size; i++)
         sort(cell_corners[i].begin(), cell_corners[i].end());
 
@@ -448,17 +542,57 @@ void select_corners(
 {
   //select stable corners
   vector<harris_corner> corners_t; 
-  for(unsigned int i=0; i<corners.size(); i++)
+  if(corners_z.size()>0)
   {
-    unsigned int j=0;
-    
-    //search the corresponding corner
-    while(j<corners_z.size() && 
-         distance2(corners[i], corners_z[j])>sigma_i*sigma_i) 
-      j++;
- 
-    if(j<corners_z.size())
-      corners_t.push_back(corners[i]);
+    //grid of the coarse corners with cells a bit larger than sigma_i, 
+    //such that corresponding corners are in neighbouring cells
+    float size=1.01*sigma_i;
+    if(size<1) size=1;
+    float x0=corners_z[0].x, y0=corners_z[0].y;
+    float x1=x0, y1=y0;
+    for(unsigned int j=1; j<corners_z.size(); j++)
+    {
+      x0=min(x0, corners_z[j].x); x1=max(x1, corners_z[j].x);
+      y0=min(y0, corners_z[j].y); y1=max(y1, corners_z[j].y);
+    }
+    int gx=(int)((x1-x0)/size)+1;
+    int gy=(int)((y1-y0)/size)+1;
+    vector<int> cell(corners_z.size());
+    vector<int> first(gx*gy+1, 0);
+    vector<int> grid(corners_z.size());
+    for(unsigned int j=0; j<corners_z.size(); j++)
+    {
+      cell[j]=(int)((corners_z[j].y-y0)/size)*gx+(int)((corners_z[j].x-x0)/size);
+      first[cell[j]+1]++;
+    }
+    for(int c=0; c<gx*gy; c++)
+      first[c+1]+=first[c];
+    vector<int> next(first.begin(), first.end()-1);
+    for(unsigned int j=0; j<corners_z.size(); j++)
+      grid[next[cell[j]]++]=j;
+
+    //search the corresponding corner in the neighbouring cells
+    vector<char> stable(corners.size(), 0);
+    #ifdef _OPENMP
+    #pragma omp parallel for
+    #endif
+    for(int i=0; i<(int)corners.size(); i++)
+    {
+      int cx=(int)floor((corners[i].x/2.-x0)/size);
+      int cy=(int)floor((corners[i].y/2.-y0)/size);
+      for(int v=max(cy-1, 0); v<=min(cy+1, gy-1) && !stable[i]; v++)
+        for(int u=max(cx-1, 0); u<=min(cx+1, gx-1) && !stable[i]; u++)
+          for(int j=first[v*gx+u]; j<first[v*gx+u+1]; j++)
+            if(distance2(corners[i], corners_z[grid[j]])<=sigma_i*sigma_i)
+            {
+              stable[i]=1;
+              break;
+            }
+    }
+
+    for(unsigned int i=0; i<corners.size(); i++)
+      if(stable[i])
+        corners_t.push_back(corners[i]);
   }
  
   corners.swap(corners_t);
@@ -489,60 +623,10 @@ void harris(
   int   verbose    //activate verbose mode
 )
 {
-  //check the dimensions of the image
-  if(nx<3 || ny<3) return;
-  
-  struct timeval start, end;
-  int size=nx*ny;
-  float *Ix=new float[size];
-  float *Iy=new float[size];
-  float *A =new float[size];
-  float *B =new float[size];
-  float *C =new float[size];
-  float *R =new float[size];
-  
-  if(verbose) 
-  {
-    Rprintf("\nHarris corner detection:\n");
-    Rprintf("[nx=%d, ny=%d, sigma_i=%f]\n", nx, ny, sigma_i);
-  }
-
-  message(" 1.Smoothing the image: \t \t", start, verbose);
-  gaussian(I, I, nx, ny, sigma_d, gauss);
-  
-  message(" 2.Computing the gradient: \t \t", start, end, verbose);
-  gradient(I, Ix, Iy, nx, ny, grad);
-
-  message(" 3.Computing the autocorrelation: \t", start, end, verbose);
-  compute_autocorrelation_matrix(Ix, Iy, A, B, C, sigma_i, nx, ny, gauss);
-
-  message(" 4.Computing corner strength function: \t", start, end, verbose);
-  compute_corner_response(A, B, C, R, measure, nx, ny, k);
-
-  message(" 5.Non-maximum suppression:  \t\t", start, end, verbose);
-  non_maximum_suppression(R, corners, Th, 2*sigma_i+0.5, nx, ny);
-
-  message(" 6.Selecting output corners:  \t\t", start, end, verbose);
-  select_output_corners(corners, strategy, cells, N, nx, ny);
-
-  if(precision==QUADRATIC_APPROXIMATION || precision==QUARTIC_INTERPOLATION)
-  {
-    message(" 7.Calculating subpixel accuracy: \t", start, end, verbose);
-    compute_subpixel_precision(R, corners, nx, precision);
-  }
-  
-  if(verbose)
-  {
-    message(start, end);
-    Rprintf(" * Number of corners detected: %zu\n", corners.size());
-  }
-  
-  delete []Ix;
-  delete []Iy;
-  delete []A;
-  delete []B;
-  delete []C;
-  delete []R;
+  harris_scale(
+    I, corners, 1, gauss, grad, measure, k, sigma_d, sigma_i, 
+    Th, strategy, cells, N, precision, nx, ny, verbose
+  );
 }
 
 
@@ -571,39 +655,147 @@ void harris_scale(
   int   verbose    //activate verbose mode
 )
 {
-  if(Nscales<=1 || nx<=64 || ny<=64)
+  vector<vector<harris_corner> > corners_s;
+  harris_scales(
+    I, corners_s, Nscales, gauss, grad, measure, k, sigma_d, 
+    vector<float>(1, sigma_i), Th, strategy, cells, N, precision, 
+    nx, ny, verbose
+  );
+  corners.insert(corners.end(), corners_s[0].begin(), corners_s[0].end());
+}
+
+
+/**
+  *
+  * Main function for computing Harris corners with scale test for 
+  * several values of sigma_i. The pyramid of the image is built and 
+  * smoothed once and used for all of them. The scales are computed 
+  * together in every step, the corners of a scale being selected with 
+  * the corners of the coarser scale at the end.
+  *
+**/
+void harris_scales(
+  float *I,        //input image
+  vector<vector<harris_corner> > &corners, //output corners per sigma_i
+  int   Nscales,   //number of scales for checking the stability of corners
+  int   gauss,     //type of Gaussian 
+  int   grad,      //type of gradient
+  int   measure,   //measure for the discriminant function
+  float k,         //Harris constant for the ....function
+  float sigma_d,   //standard deviation for smoothing (image denoising)    
+  const vector<float> &sigma_i, //standard deviations for smoothing (pixel neighbourhood)
+  float Th,        //threshold for eliminating low values
+  int   strategy,  //strategy for the output corners
+  int   cells,     //number of regions in the image for distributed output
+  int   N,         //number of output corners
+  int   precision, //type of subpixel precision approximation
+  int   nx,        //number of columns of the image
+  int   ny,        //number of rows of the image
+  int   verbose    //activate verbose mode
+)
+{
+  corners.assign(sigma_i.size(), vector<harris_corner>());
+
+  //check the dimensions of the image
+  if(nx<3 || ny<3) return;
+
+  struct timeval start, end;
+
+  //zoom out the image by a factor of 2 until the coarsest scale
+  vector<harris_level> levels(1);
+  levels[0].I=I;
+  levels[0].nx=nx;
+  levels[0].ny=ny;
+  for(int l=1; l<Nscales && levels[l-1].nx>64 && levels[l-1].ny>64; l++)
   {
-    //compute Harris' corners at coarsest scale
-    harris(
-      I, corners, gauss, grad, measure, k, sigma_d, sigma_i, 
-      Th, strategy, cells, N, precision, nx, ny, verbose
-    );
-  } 
-  else
+    harris_level level;
+    level.I =zoom_out(levels[l-1].I, levels[l-1].nx, levels[l-1].ny);
+    level.nx=levels[l-1].nx/2;
+    level.ny=levels[l-1].ny/2;
+    level.R =NULL;
+    level.sigma_i=0;
+    levels.push_back(level);
+  }
+  int L=levels.size();
+  for(int l=0; l<L; l++)
+    levels[l].R=new float[levels[l].nx*levels[l].ny];
+  
+  if(verbose) 
   {
-    //zoom out the image by a factor of 2
-    float *Iz=zoom_out(I, nx, ny);
-    
-    //compute Harris' corners at the coarse scale (recursive)
-    vector<harris_corner> corners_z; 
-    harris_scale(
-      Iz, corners_z, Nscales-1, gauss, grad, measure, k, sigma_d, 
-      sigma_i/2, Th, strategy, cells, N, precision, nx/2, ny/2, verbose
-    );
-    
-    delete []Iz;
+    Rprintf("\nHarris corner detection:\n");
+    for(int l=0; l<L; l++)
+      Rprintf("[nx=%d, ny=%d]\n", levels[l].nx, levels[l].ny);
+  }
 
-    //compute Harris' corners at the current scale
-    harris(
-      I, corners, gauss, grad, measure, k, sigma_d, sigma_i, 
-      Th, strategy, cells, N, precision, nx, ny, verbose
-    );
+  message(" 1.Smoothing the image: \t \t", start, verbose);
+  for(int l=0; l<L; l++)
+    gaussian(levels[l].I, levels[l].I, levels[l].nx, levels[l].ny, sigma_d, gauss);
+
+  for(unsigned int s=0; s<sigma_i.size(); s++)
+  {
+    levels[0].sigma_i=sigma_i[s];
+    for(int l=1; l<L; l++)
+      levels[l].sigma_i=levels[l-1].sigma_i/2;
+
+    if(s==0)
+      message(" 2.Gradient, autocorrelation, strength: \t", start, end, verbose);
+    else
+      message(" 2.Gradient, autocorrelation, strength: \t", start, verbose);
+    compute_autocorrelation_response(levels, grad, gauss, measure, k);
+
+    message(" 3.Non-maximum suppression:  \t\t", start, end, verbose);
+    for(int l=0; l<L; l++)
+    {
+      levels[l].corners.clear();
+      non_maximum_suppression(
+        levels[l].R, levels[l].corners, Th, 2*levels[l].sigma_i+0.5, 
+        levels[l].nx, levels[l].ny
+      );
+    }
+
+    message(" 4.Selecting output corners:  \t\t", start, end, verbose);
+    for(int l=0; l<L; l++)
+      select_output_corners(
+        levels[l].corners, strategy, cells, N, levels[l].nx, levels[l].ny
+      );
 
-    //select stable corners
-    select_corners(corners, corners_z, sigma_i);
+    if(precision==QUADRATIC_APPROXIMATION || precision==QUARTIC_INTERPOLATION)
+    {
+      message(" 5.Calculating subpixel accuracy: \t", start, end, verbose);
+      for(int l=0; l<L; l++)
+        compute_subpixel_precision(
+          levels[l].R, levels[l].corners, levels[l].nx, precision
+        );
+    }
     
     if(verbose)
-      Rprintf(" * Number of corners after scale check: %zu\n", corners.size());
+    {
+      message(start, end);
+      for(int l=L-1; l>=0; l--)
+        Rprintf(
+          " * Number of corners detected [nx=%d, ny=%d, sigma_i=%f]: %zu\n", 
+          levels[l].nx, levels[l].ny, levels[l].sigma_i, levels[l].corners.size()
+        );
+    }
+
+    //select stable corners from the coarsest to the finest scale
+    for(int l=L-1; l>0; l--)
+    {
+      select_corners(levels[l-1].corners, levels[l].corners, levels[l-1].sigma_i);
+    
+      if(verbose)
+        Rprintf(
+          " * Number of corners after scale check [nx=%d, ny=%d]: %zu\n", 
+          levels[l-1].nx, levels[l-1].ny, levels[l-1].corners.size()
+        );
+    }
+
+    corners[s].swap(levels[0].corners);
   }
-}
 
+  for(int l=0; l<L; l++)
+  {
+    if(l>0) delete []levels[l].I;
+    delete []levels[l].R;
+  }
+}
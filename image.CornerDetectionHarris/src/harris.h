@@ -140,4 +140,31 @@ void harris_scale(
   int   verbose    //activate verbose mode
 );
 
+
+/**
+  *
+  * Main function for computing Harris corners with scale test for 
+  * several values of sigma_i, sharing the pyramid of the image
+  *
+**/
+void harris_scales(
+  float *I,        //input image
+  std::vector<std::vector<harris_corner> > &corners, //output corners per sigma_i
+  int   Nscales,   //number of scales for checking the stability of corners
+  int   gauss,     //type of Gaussian 
+  int   grad,      //type of gradient
+  int   measure,   //measure for the discriminant function
+  float k,         //Harris constant for the ....function
+  float sigma_d,   //standard deviation for smoothing (image denoising)    
+  const std::vector<float> &sigma_i, //standard deviations for smoothing (pixel neighbourhood)
+  float Th,        //threshold for eliminating low values
+  int   strategy,  //strategy for the output corners
+  int   cells,     //number of regions in the image for distributed output
+  int   N,         //number of output corners
+  int   precision, //type of subpixel precision approximation
+  int   nx,        //number of columns of the image
+  int   ny,        //number of rows of the image
+  int   verbose    //activate verbose mode
+);
+
 #endif
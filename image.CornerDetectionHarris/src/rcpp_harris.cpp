@@ -19,7 +19,7 @@
 SEXP detect_corners(Rcpp::NumericVector x, int nx, int ny, 
                     float k=0.060000,
                     float sigma_d=1.000000,
-                    float sigma_i=2.500000, 
+                    Rcpp::NumericVector sigma_i=Rcpp::NumericVector::create(2.500000), 
                     float threshold=130,
                     int gaussian=1,
                     int gradient=0,
@@ -30,31 +30,34 @@ SEXP detect_corners(Rcpp::NumericVector x, int nx, int ny,
                     int precision=1,
                     int cells=10,
                     int verbose=1) {
-  std::vector<harris_corner> corners;
+  std::vector<std::vector<harris_corner> > corners;
+  std::vector<float> sigma(sigma_i.begin(), sigma_i.end());
   float *I=new float[nx*ny];
   for(int i = 0; i < x.size(); i++) I[i] = (float)x[i];
   
-  harris_scale(
+  harris_scales(
     I, corners, Nscales, gaussian, gradient, measure, k, 
-    sigma_d, sigma_i, threshold, strategy, cells, Nselect, 
+    sigma_d, sigma, threshold, strategy, cells, Nselect, 
     precision, nx, ny, verbose
   );
+  delete []I;
   
-  unsigned int nr_corners = corners.size();
-  std::vector<float> loc_x;
-  std::vector<float> loc_y;
-  std::vector<float> loc_strength;
-  for (unsigned int i = 0; i < nr_corners; i++){
-    loc_x.push_back(corners[i].x);
-    loc_y.push_back(corners[i].y);
-    loc_strength.push_back(corners[i].R);
+  Rcpp::List out(corners.size());
+  for (unsigned int s = 0; s < corners.size(); s++){
+    unsigned int nr_corners = corners[s].size();
+    std::vector<float> loc_x;
+    std::vector<float> loc_y;
+    std::vector<float> loc_strength;
+    for (unsigned int i = 0; i < nr_corners; i++){
+      loc_x.push_back(corners[s][i].x);
+      loc_y.push_back(corners[s][i].y);
+      loc_strength.push_back(corners[s][i].R);
+    }
+    out[s] = Rcpp::List::create(
+      Rcpp::Named("x") = loc_x,
+      Rcpp::Named("y") = loc_y,
+      Rcpp::Named("strength") = loc_strength
+    );
   }
-  
-  Rcpp::List out = Rcpp::List::create(
-    Rcpp::Named("x") = loc_x,
-    Rcpp::Named("y") = loc_y,
-    Rcpp::Named("strength") = loc_strength
-  );
   return out;
 }
-
@@ -41,248 +41,448 @@
 
 #include "libdenoising.h"
 
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
+// rows of the bands of the image processed by the threads
+#define NLMEANS_BAND_ROWS 32
 
 
 
 
-void nlmeans_ipol(int iDWin,            // Half size of patch
-                  int iDBloc,           // Half size of research window
-                  float fSigma,         // Noise parameter
-                  float fFiltPar,       // Filtering parameter
-                  float **fpI,          // Input
-                  float **fpO,          // Output
-                  int iChannels, int iWidth,int iHeight) {
-
 
+// half size of the comparison window of pixel (x,y), reduced near the boundary
+static inline int nlmeans_radius(int x, int y, int iDWin, int iWidth, int iHeight) {
+    return MIN(iDWin,MIN(iWidth-1-x,MIN(iHeight-1-y,MIN(x,y))));
+}
 
 
-    // length of each channel
-    int iwxh = iWidth * iHeight;
 
 
-    //  length of comparison window
-    int ihwl = (2*iDWin+1);
-    int iwl = (2*iDWin+1) * (2*iDWin+1);
-    int icwl = iChannels * iwl;
+// wxSLUT for dif >= 0, inlined in the loop over the pixels
+static inline float nlmeans_lut(float dif, float *lut) {
 
+    if (dif >= (float) LUTMAXM1) return 0.0;
 
+    int  x= (int) ((double) dif * (float) LUTPRECISION);
 
-    // filtering parameter
-    float fSigma2 = fSigma * fSigma;
-    float fH = fFiltPar * fSigma;
-    float fH2 = fH * fH;
+    float y1=lut[x];
+    float y2=lut[x+1];
 
-    // multiply by size of patch, since distances are not normalized
-    fH2 *= (float) icwl;
+    return y1 + (y2-y1)*(dif*LUTPRECISION -  x);
+}
 
 
 
-    // tabulate exp(-x), faster than using directly function expf
-    int iLutLength = (int) rintf((float) LUTMAX * (float) LUTPRECISION);
-    float *fpLut = new float[iLutLength];
-    wxFillExpLut(fpLut,iLutLength);
 
+// weights of the patches of the pixels (x,y) of rows ya <= y < yb with the
+// patches centered at (x+dx,y+dy), zero where the displaced patch does not fit
+// in the image. fpWeight[(y-ya) * iWidth + x] is the weight of (x,y).
+// The distances are box sums of an integral image of the squared differences
+// between the image and the displaced image, over the rows reached by the
+// patches of the band.
+static void nlmeans_weights(int dx, int dy,         // Displacement
+                            int iDWin,              // Half size of patch
+                            float fSigma2,          // Square of noise parameter
+                            float fH2,              // Square of filtering parameter
+                            int icwl,               // Number of values of a patch
+                            float *fpLut,           // exp(-x) lut
+                            float **fpI,            // Input
+                            int ya, int yb,         // Rows of the band
+                            double *dpIntegral,     // (iWidth+1) x (yb-ya+2*iDWin+1) integral image
+                            float *fpWeight,        // Output weights
+                            int iChannels, int iWidth, int iHeight) {
 
+    int iw1 = iWidth + 1;
+    int ioff = dy * iWidth + dx;
 
+    // rows reached by the patches of the band
+    int ia = MAX(0, ya - iDWin), ib = MIN(iHeight, yb + iDWin);
 
-    // auxiliary variable
-    // number of denoised values per pixel
-    float *fpCount = new float[iwxh];
-    fpClear(fpCount, 0.0f,iwxh);
+    // columns and rows for which the displaced pixel is in the image
+    int x0 = MAX(0, -dx), x1 = MIN(iWidth, iWidth - dx);
+    int y0 = MAX(0, -dy), y1 = MIN(iHeight, iHeight - dy);
 
 
+    // integral image of the squared differences, row y of the image
+    // ending at row y-ia+1
+    for (int x=0; x <= iWidth; x++) dpIntegral[x] = 0.0;
 
+    for (int y=ia; y < ib; y++) {
 
-    // clear output
-    for (int ii=0; ii < iChannels; ii++) fpClear(fpO[ii], 0.0f, iwxh);
+        double *dpRow = &dpIntegral[(y-ia+1) * iw1];
+        double *dpAbove = &dpIntegral[(y-ia) * iw1];
+        double dSum = 0.0;
 
+        dpRow[0] = 0.0;
+        if (y < y0 || y >= y1) {
+            for (int x=0; x < iWidth; x++) dpRow[x+1] = dpAbove[x+1];
+            continue;
+        }
 
+        for (int x=0; x < x0; x++) dpRow[x+1] = dpAbove[x+1];
 
+        for (int x=x0; x < x1; x++) {
+            int il = y * iWidth + x;
+            float fDist = 0.0f;
+            for (int ii=0; ii < iChannels; ii++) {
+                float dif = fpI[ii][il] - fpI[ii][il + ioff];
+                fDist += dif * dif;
+            }
+            dSum += fDist;
+            dpRow[x+1] = dpAbove[x+1] + dSum;
+        }
 
-    // PROCESS STARTS
-    // for each pixel (x,y)
-#pragma omp parallel shared(fpI, fpO)
-    {
+        for (int x=x1; x < iWidth; x++) dpRow[x+1] = dpAbove[x+1] + dSum;
+    }
 
 
-#pragma omp for schedule(dynamic) nowait
+    float fOffset = 2.0f * (float) icwl *  fSigma2;
 
-        for (int y=0; y < iHeight ; y++) {
+    for (int y=ya; y < yb; y++) {
 
+        int j = y + dy;
+        float *fpRow = &fpWeight[(y-ya) * iWidth];
 
-            // auxiliary variable
-            // denoised patch centered at a certain pixel
-            float **fpODenoised = new float*[iChannels];
-            for (int ii=0; ii < iChannels; ii++) fpODenoised[ii] = new float[iwl];
+        // columns away from the boundary, where the radius only depends on y
+        int ry = MIN(iDWin, MIN(y, iHeight-1-y));
+        int xa = MIN(iDWin, iWidth), xb = MAX(xa, iWidth-iDWin);
 
+        for (int x=0; x < iWidth; x++) {
 
+            if (x == xa) {
 
+                // research zone depending on the boundary and the size of the window
+                int lo = xb, hi = xb;
+                if (j >= ry && j <= iHeight-1-ry) {
+                    lo = MIN(xb, MAX(xa, ry-dx));
+                    hi = MAX(lo, MIN(xb, iWidth-ry-dx));
+                }
 
+                int iBot = (y+ry+1-ia) * iw1, iTop = (y-ry-ia) * iw1;
 
-            for (int x=0 ; x < iWidth;  x++) {
+                for (x=xa; x < lo; x++) fpRow[x] = 0.0f;
+                for (; x < hi; x++) {
+                    float fDif = (float) (dpIntegral[iBot + x+ry+1] - dpIntegral[iTop + x+ry+1]
+                                        - dpIntegral[iBot + x-ry] + dpIntegral[iTop + x-ry]);
+                    fDif = MAX(fDif - fOffset, 0.0f);
+                    fDif = fDif / fH2;
+                    fpRow[x] = nlmeans_lut(fDif,fpLut);
+                }
+                for (; x < xb; x++) fpRow[x] = 0.0f;
 
-                // reduce the size of the comparison window if we are near the boundary
-                int iDWin0 = MIN(iDWin,MIN(iWidth-1-x,MIN(iHeight-1-y,MIN(x,y))));
+                if (x >= iWidth) break;
+            }
 
+            int r = nlmeans_radius(x, y, iDWin, iWidth, iHeight);
+            int i = x + dx;
 
-                // research zone depending on the boundary and the size of the window
-                int imin=MAX(x-iDBloc,iDWin0);
-                int jmin=MAX(y-iDBloc,iDWin0);
+            if (i < r || i > iWidth-1-r || j < r || j > iHeight-1-r) {
+                fpRow[x] = 0.0f;
+                continue;
+            }
 
-                int imax=MIN(x+iDBloc,iWidth-1-iDWin0);
-                int jmax=MIN(y+iDBloc,iHeight-1-iDWin0);
+            float fDif = (float) (dpIntegral[(y+r+1-ia) * iw1 + x+r+1] - dpIntegral[(y-r-ia) * iw1 + x+r+1]
+                                - dpIntegral[(y+r+1-ia) * iw1 + x-r] + dpIntegral[(y-r-ia) * iw1 + x-r]);
 
+            // dif^2 - 2 * fSigma^2 * N      dif is not normalized
+            fDif = MAX(fDif - fOffset, 0.0f);
+            fDif = fDif / fH2;
 
+            fpRow[x] = nlmeans_lut(fDif,fpLut);
+        }
+    }
+}
 
-                //  clear current denoised patch
-                for (int ii=0; ii < iChannels; ii++) fpClear(fpODenoised[ii], 0.0f, iwl);
 
 
 
-                // maximum of weights. Used for reference patch
-                float fMaxWeight = 0.0f;
+// add value fpValue of every pixel p of rows ra <= y < rb to the comparison
+// window of p, for the pixels where fpValue is not zero, with ra and rb the
+// rows whose windows reach the band ya <= y < yb. fpValue[(y-ra) * iWidth + x]
+// is the value of (x,y). The windows are added as corners of a difference
+// image, of which the cumulative sums give the sum over the windows containing
+// every pixel. Returns the sums of row ya, followed by the next rows of the
+// band with a stride of iWidth+1.
+static const double *nlmeans_windows(int iDWin,              // Half size of patch
+                                     float *fpValue,         // Value of each window
+                                     int ya, int yb,         // Rows of the band
+                                     double *dpSum,          // (iWidth+1) x (yb-ya+2*iDWin+1) sums
+                                     int iWidth, int iHeight) {
 
+    int iw1 = iWidth + 1;
+    int ra = MAX(0, ya - iDWin), rb = MIN(iHeight, yb + iDWin);
 
-                // sum of weights
-                float fTotalWeight = 0.0f;
+    // first row of a window of the rows ra <= y < rb
+    int da = MAX(0, ra - iDWin);
 
+    for (int ii=0; ii < iw1 * (yb-da); ii++) dpSum[ii] = 0.0;
 
-                for (int j=jmin; j <= jmax; j++)
-                    for (int i=imin ; i <= imax; i++)
-                        if (i!=x || j!=y) {
+    for (int y=ra; y < rb; y++)
+        for (int x=0; x < iWidth; x++) {
 
-                            float fDif = fiL2FloatDist(fpI,fpI,x,y,i,j,iDWin0,iChannels,iWidth,iWidth);
+            float fValue = fpValue[(y-ra) * iWidth + x];
+            if (fValue == 0.0f) continue;
 
-                            // dif^2 - 2 * fSigma^2 * N      dif is not normalized
-                            fDif = MAX(fDif - 2.0f * (float) icwl *  fSigma2, 0.0f);
-                            fDif = fDif / fH2;
+            int r = nlmeans_radius(x, y, iDWin, iWidth, iHeight);
+            if (y-r >= yb) continue;
+            dpSum[(y-r-da) * iw1 + x-r] += fValue;
+            dpSum[(y-r-da) * iw1 + x+r+1] -= fValue;
+            if (y+r+1 >= yb) continue;
+            dpSum[(y+r+1-da) * iw1 + x-r] -= fValue;
+            dpSum[(y+r+1-da) * iw1 + x+r+1] += fValue;
+        }
 
-                            float fWeight = wxSLUT(fDif,fpLut);
+    for (int y=0; y < yb-da; y++) {
+        double dSum = 0.0;
+        for (int x=0; x < iWidth; x++) {
+            dSum += dpSum[y * iw1 + x];
+            dpSum[y * iw1 + x] = (y > 0 ? dpSum[(y-1) * iw1 + x] : 0.0) + dSum;
+        }
+    }
 
-                            if (fWeight > fMaxWeight) fMaxWeight = fWeight;
+    return &dpSum[(ya-da) * iw1];
+}
 
-                            fTotalWeight += fWeight;
 
 
-                            for (int is=-iDWin0; is <=iDWin0; is++) {
-                                int aiindex = (iDWin+is) * ihwl + iDWin;
-                                int ail = (j+is)*iWidth+i;
 
-                                for (int ir=-iDWin0; ir <= iDWin0; ir++) {
+// The patches of all pixels are compared displacement by displacement: the
+// squared differences between the image and the image displaced by (dx,dy)
+// are summed over all patches at once with an integral image. The image is
+// split in bands of NLMEANS_BAND_ROWS rows which are processed by the threads,
+// every band running over all the displacements, so that the result does not
+// depend on the number of threads. A first pass gives the sum and maximum of
+// the weights of every pixel. A second one recomputes the weights of the band
+// and of the iDWin rows around it, whose comparison windows reach the band,
+// and adds the weighted displaced patches, divided by the sum of the weights,
+// to the comparison windows. Besides the float sums of the weights over the
+// image, every thread only needs buffers of the size of a band.
+void nlmeans_ipol(int iDWin,            // Half size of patch
+                  int iDBloc,           // Half size of research window
+                  float fSigma,         // Noise parameter
+                  float fFiltPar,       // Filtering parameter
+                  float **fpI,          // Input
+                  float **fpO,          // Output
+                  int iChannels, int iWidth,int iHeight) {
 
-                                    int iindex = aiindex + ir;
-                                    int il= ail +ir;
 
-                                    for (int ii=0; ii < iChannels; ii++)
-                                        fpODenoised[ii][iindex] += fWeight * fpI[ii][il];
 
-                                }
 
-                            }
+    // length of each channel
+    int iwxh = iWidth * iHeight;
+    int iw1 = iWidth + 1;
 
 
-                        }
+    //  length of comparison window
+    int iwl = (2*iDWin+1) * (2*iDWin+1);
+    int icwl = iChannels * iwl;
 
 
 
+    // filtering parameter
+    float fSigma2 = fSigma * fSigma;
+    float fH = fFiltPar * fSigma;
+    float fH2 = fH * fH;
 
-                // current patch with fMaxWeight
-                for (int is=-iDWin0; is <=iDWin0; is++) {
-                    int aiindex = (iDWin+is) * ihwl + iDWin;
-                    int ail=(y+is)*iWidth+x;
+    // multiply by size of patch, since distances are not normalized
+    fH2 *= (float) icwl;
 
-                    for (int ir=-iDWin0; ir <= iDWin0; ir++) {
 
-                        int iindex = aiindex + ir;
-                        int il=ail+ir;
 
-                        for (int ii=0; ii < iChannels; ii++)
-                            fpODenoised[ii][iindex] += fMaxWeight * fpI[ii][il];
+    // tabulate exp(-x), faster than using directly function expf
+    int iLutLength = (int) rintf((float) LUTMAX * (float) LUTPRECISION);
+    float *fpLut = new float[iLutLength];
+    wxFillExpLut(fpLut,iLutLength);
 
-                    }
-                }
 
 
+    // displacements (dx,dy) within the research window, except (0,0)
+    int iDx = MIN(iDBloc, iWidth-1), iDy = MIN(iDBloc, iHeight-1);
+    std::vector<int> dxs, dys;
+    for (int dy=-iDy; dy <= iDy; dy++)
+        for (int dx=-iDx; dx <= iDx; dx++)
+            if (dx != 0 || dy != 0) {
+                dxs.push_back(dx);
+                dys.push_back(dy);
+            }
+    int iNDisp = dxs.size();
 
-                fTotalWeight += fMaxWeight;
 
+    // bands of rows
+    int iBandRows = MIN(NLMEANS_BAND_ROWS, iHeight);
+    int iNBands = (iHeight + iBandRows - 1) / iBandRows;
 
+    int iThreads = 1;
+#ifdef _OPENMP
+    iThreads = omp_get_max_threads();
+#endif
+    iThreads = MAX(1, MIN(iThreads, iNBands));
 
 
+    // sizes of the buffers of a band, with the rows around it
+    int iBandSize = iBandRows * iWidth;
+    int iHaloSize = (iBandRows + 2*iDWin) * iWidth;
+    int iIntegralSize = (iBandRows + 4*iDWin + 1) * iw1;
 
 
 
-                // normalize average value when fTotalweight is not near zero
-                if (fTotalWeight > fTiny) {
+    // auxiliary variables
+    // sum of the weights, including the maximum weight, of every pixel
+    float *fpTotal = new float[iwxh];
+    // weight of the patch of every pixel with itself, normalized
+    float *fpValue = new float[iwxh];
 
 
 
-                    for (int is=-iDWin0; is <=iDWin0; is++) {
-                        int aiindex = (iDWin+is) * ihwl + iDWin;
-                        int ail=(y+is)*iWidth+x;
 
-                        for (int ir=-iDWin0; ir <= iDWin0; ir++) {
-                            int iindex = aiindex + ir;
-                            int il=ail+ ir;
+    // PROCESS STARTS
+    // sum and maximum of the weights of the patches of every pixel
+#pragma omp parallel num_threads(iThreads)
+    {
+        double *dpIntegral = new double[iIntegralSize];
+        float *fpWeight = new float[iBandSize];
+        double *dpTotal = new double[iBandSize];
+        float *fpMax = new float[iBandSize];
 
-                            fpCount[il]++;
+#pragma omp for schedule(dynamic)
+        for (int b=0; b < iNBands; b++) {
 
-                            for (int ii=0; ii < iChannels; ii++) {
-                                fpO[ii][il] += fpODenoised[ii][iindex] / fTotalWeight;
+            int ya = b * iBandRows, yb = MIN(iHeight, ya + iBandRows);
+            int n = (yb - ya) * iWidth;
 
-                            }
+            for (int ii=0; ii < n; ii++) {
+                dpTotal[ii] = 0.0;
+                fpMax[ii] = 0.0f;
+            }
 
-                        }
-                    }
+            for (int d=0; d < iNDisp; d++) {
 
+                nlmeans_weights(dxs[d], dys[d], iDWin, fSigma2, fH2, icwl, fpLut, fpI,
+                                ya, yb, dpIntegral, fpWeight, iChannels, iWidth, iHeight);
 
+                for (int ii=0; ii < n; ii++) {
+                    dpTotal[ii] += fpWeight[ii];
+                    if (fpWeight[ii] > fpMax[ii]) fpMax[ii] = fpWeight[ii];
                 }
+            }
 
+            // current patch with fMaxWeight
+            for (int ii=0; ii < n; ii++) {
+                int il = ya * iWidth + ii;
+                fpTotal[il] = (float) (dpTotal[ii] + fpMax[ii]);
+                fpValue[il] = fpTotal[il] > fTiny ? fpMax[ii] / fpTotal[il] : 0.0f;
+            }
+        }
 
+        delete[] dpIntegral;
+        delete[] fpWeight;
+        delete[] dpTotal;
+        delete[] fpMax;
+    }
 
 
 
 
-            }
+    // weighted patches, normalized by the sum of the weights of the 
+    // reference pixel, added to the comparison window
+#pragma omp parallel num_threads(iThreads)
+    {
+        double *dpIntegral = new double[iIntegralSize];
+        float *fpWeight = new float[iHaloSize];
+        // weighted sum of the patches containing every pixel of the band
+        double *dpDenoised = new double[iChannels * iBandSize];
 
+#pragma omp for schedule(dynamic)
+        for (int b=0; b < iNBands; b++) {
 
+            int ya = b * iBandRows, yb = MIN(iHeight, ya + iBandRows);
+            int n = (yb - ya) * iWidth;
 
-            for (int ii=0; ii < iChannels; ii++) delete[] fpODenoised[ii];
-            delete[] fpODenoised;
+            // rows whose comparison windows reach the band
+            int ra = MAX(0, ya - iDWin), rb = MIN(iHeight, yb + iDWin);
+            int nr = (rb - ra) * iWidth;
 
+            for (int ii=0; ii < iChannels * iBandSize; ii++) dpDenoised[ii] = 0.0;
 
-        }
+            for (int d=0; d < iNDisp; d++) {
 
+                int dx = dxs[d], dy = dys[d];
+                int ioff = dy * iWidth + dx;
 
+                nlmeans_weights(dx, dy, iDWin, fSigma2, fH2, icwl, fpLut, fpI,
+                                ra, rb, dpIntegral, fpWeight, iChannels, iWidth, iHeight);
 
+                for (int ii=0; ii < nr; ii++) {
+                    float fTotal = fpTotal[ra * iWidth + ii];
+                    fpWeight[ii] = fTotal > fTiny ? fpWeight[ii] / fTotal : 0.0f;
+                }
 
-    }
+                const double *dpWin = nlmeans_windows(iDWin, fpWeight, ya, yb, dpIntegral, iWidth, iHeight);
 
+                // pixels of which the displaced pixel is in the image
+                for (int y=MAX(ya, -dy); y < MIN(yb, iHeight - dy); y++)
+                    for (int x=MAX(0, -dx); x < MIN(iWidth, iWidth - dx); x++) {
 
+                        double dWeight = dpWin[(y-ya) * iw1 + x];
+                        if (dWeight == 0.0) continue;
 
+                        int il = y * iWidth + x;
+                        for (int ii=0; ii < iChannels; ii++)
+                            dpDenoised[ii * iBandSize + il - ya * iWidth] += dWeight * fpI[ii][il + ioff];
+                    }
+            }
 
 
+            // current patch with fMaxWeight
+            const double *dpWin = nlmeans_windows(iDWin, &fpValue[ra * iWidth], ya, yb, dpIntegral, iWidth, iHeight);
 
+            for (int ii=0; ii < n; ii++) {
+                double dDenoised = dpWin[(ii / iWidth) * iw1 + ii % iWidth];
+                for (int jj=0; jj < iChannels; jj++)
+                    dpDenoised[jj * iBandSize + ii] += dDenoised * fpI[jj][ya * iWidth + ii];
+            }
+
+
+            // number of denoised values per pixel
+            for (int ii=0; ii < nr; ii++) fpWeight[ii] = fpTotal[ra * iWidth + ii] > fTiny ? 1.0f : 0.0f;
+            dpWin = nlmeans_windows(iDWin, fpWeight, ya, yb, dpIntegral, iWidth, iHeight);
+
+
+
+            for (int ii=0; ii < n; ii++) {
 
+                double dCount = dpWin[(ii / iWidth) * iw1 + ii % iWidth];
+                int il = ya * iWidth + ii;
 
+                if (dCount > 0.5) {
 
-    for (int ii=0; ii < iwxh; ii++)
-        if (fpCount[ii]>0.0) {
-            for (int jj=0; jj < iChannels; jj++)  fpO[jj][ii] /= fpCount[ii];
+                    for (int jj=0; jj < iChannels; jj++)
+                        fpO[jj][il] = (float) (dpDenoised[jj * iBandSize + ii] / rint(dCount));
 
-        }       else {
+                }       else {
 
-            for (int jj=0; jj < iChannels; jj++)  fpO[jj][ii] = fpI[jj][ii];
+                    for (int jj=0; jj < iChannels; jj++)  fpO[jj][il] = fpI[jj][il];
+                }
+
+            }
         }
 
+        delete[] dpIntegral;
+        delete[] fpWeight;
+        delete[] dpDenoised;
+    }
+
 
 
 
     // delete memory
     delete[] fpLut;
-    delete[] fpCount;
+    delete[] fpTotal;
+    delete[] fpValue;
 
 
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,185 @@
+/*----------------------------------------------------------------------------
+
+  Separable Gaussian filtering and sub-sampling of graylevel images.
+
+  The same gaussian_sampler.c and gaussian_sampler.h are part of
+  image.ContourDetector and image.LineSegmentDetector, keep both copies
+  identical.
+
+  ----------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "gaussian_sampler.h"
+
+/*----------------------------------------------------------------------------*/
+/* number of output columns of the vertical pass accumulated at once */
+#define COLUMN_BLOCK 512
+
+/*----------------------------------------------------------------------------*/
+/* index in 0..n-1 of coordinate j under the symmetric boundary condition
+ */
+static int symmetric(int j, int n)
+{
+  int n2 = 2*n;
+  while( j < 0 ) j += n2;
+  while( j >= n2 ) j -= n2;
+  return j >= n ? n2-1-j : j;
+}
+
+/*----------------------------------------------------------------------------*/
+/* normalized Gaussian kernels of size 2h+1 for the n samples along an axis.
+
+   sample x is at coordinate x/scale of the input, and its kernel applies to
+   the input pixels start[x] .. start[x]+2h. the kernel is computed centered
+   on the sample, so the fine offset between the sample and the nearest pixel
+   is interpolated by the kernel itself.
+ */
+static void sampling_kernels( float * kernels, int * start, int n, int h,
+                              double scale, double sigma )
+{
+  int x,i,xc;
+  double xx,mean,val,sum;
+
+  for(x=0; x<n; x++)
+    {
+      /* coordinate (0.0,0.0) is in the center of pixel (0,0),
+         so the pixel with xc=0 get the values of xx from -0.5 to 0.5 */
+      xx = (double) x / scale;
+      xc = (int) floor( xx + 0.5 );
+      mean = (double) h + xx - (double) xc;
+      sum = 0.0;
+      for(i=0; i<=2*h; i++)
+        {
+          val = ( (double) i - mean ) / sigma;
+          sum += exp( -0.5 * val * val );
+        }
+      for(i=0; i<=2*h; i++)
+        {
+          val = ( (double) i - mean ) / sigma;
+          kernels[x*(2*h+1)+i] = (float) ( exp( -0.5 * val * val ) / sum );
+        }
+      start[x] = xc - h;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/* the image is traversed row by row in both passes.
+
+   the horizontal pass copies every input row into a buffer padded with h
+   pixels of symmetric boundary on the left and h+1 on the right, so the
+   kernels read contiguous memory without boundary tests. the vertical pass
+   accumulates, for each output row, the 2h+1 input rows scaled by the kernel
+   weights into a block of columns that stays in cache. rows are distributed
+   over the threads in contiguous bands.
+ */
+int gaussian_sampler_data( const double * in, int X, int Y, double * out,
+                           double scale, double sigma, int threads )
+{
+  int N = (int) ceil( X * scale );
+  int M = (int) ceil( Y * scale );
+  /* the first discarded term is at least 10^prec times smaller than the
+     central value, for that h > x with e^(-x^2/2sigma^2) = 1/10^prec */
+  double prec = 3.0;
+  int h = (int) ceil( sigma * sqrt( 2.0 * prec * log(10.0) ) );
+  int dim = 2*h+1;
+  int PX = X + 2*h + 1;  /* padded sizes: the kernels reach pixels -h..X+h */
+  int PY = Y + 2*h + 1;
+  int W = PX > COLUMN_BLOCK ? PX : COLUMN_BLOCK;
+  int x,y,res = -1;
+  float * kx, * ky, * aux, * work;
+  int * sx, * sy, * cols, * rows;
+
+  if( threads < 1 )
+    {
+      threads = 1;
+#ifdef _OPENMP
+      threads = omp_get_max_threads();
+#endif
+    }
+
+  kx = (float *) malloc( (size_t) N * dim * sizeof(float) );
+  ky = (float *) malloc( (size_t) M * dim * sizeof(float) );
+  sx = (int *) malloc( N * sizeof(int) );
+  sy = (int *) malloc( M * sizeof(int) );
+  cols = (int *) malloc( PX * sizeof(int) );
+  rows = (int *) malloc( PY * sizeof(int) );
+  aux = (float *) malloc( (size_t) N * Y * sizeof(float) );
+  work = (float *) malloc( (size_t) threads * W * sizeof(float) );
+  if( kx == NULL || ky == NULL || sx == NULL || sy == NULL ||
+      cols == NULL || rows == NULL || aux == NULL || work == NULL )
+    goto done;
+
+  sampling_kernels(kx, sx, N, h, scale, sigma);
+  sampling_kernels(ky, sy, M, h, scale, sigma);
+  for(x=0; x<PX; x++) cols[x] = symmetric(x-h, X);
+  for(y=0; y<PY; y++) rows[y] = symmetric(y-h, Y);
+
+  /* x axis: aux is N x Y */
+#pragma omp parallel for schedule(static) num_threads(threads)
+  for(y=0; y<Y; y++)
+    {
+      int t = 0;
+      int i,xs;
+      float * pad;
+      const double * src = in + (size_t) y * X;
+      float * dst = aux + (size_t) y * N;
+#ifdef _OPENMP
+      t = omp_get_thread_num();
+#endif
+      pad = work + (size_t) t * W;
+      for(xs=0; xs<PX; xs++) pad[xs] = (float) src[cols[xs]];
+      for(xs=0; xs<N; xs++)
+        {
+          const float * k = kx + (size_t) xs * dim;
+          const float * p = pad + sx[xs] + h;
+          float sum = 0.0f;
+#pragma omp simd reduction(+:sum)
+          for(i=0; i<dim; i++) sum += k[i] * p[i];
+          dst[xs] = sum;
+        }
+    }
+
+  /* y axis: out is N x M */
+#pragma omp parallel for schedule(static) num_threads(threads)
+  for(y=0; y<M; y++)
+    {
+      int t = 0;
+      int i,x0,x1,xs;
+      float * acc;
+      const float * k = ky + (size_t) y * dim;
+      double * dst = out + (size_t) y * N;
+#ifdef _OPENMP
+      t = omp_get_thread_num();
+#endif
+      acc = work + (size_t) t * W;
+      for(x0=0; x0<N; x0+=COLUMN_BLOCK)
+        {
+          x1 = x0 + COLUMN_BLOCK < N ? x0 + COLUMN_BLOCK : N;
+          for(xs=x0; xs<x1; xs++) acc[xs-x0] = 0.0f;
+          for(i=0; i<dim; i++)
+            {
+              const float * src = aux + (size_t) rows[sy[y]+h+i] * N;
+              float ki = k[i];
+#pragma omp simd
+              for(xs=x0; xs<x1; xs++) acc[xs-x0] += ki * src[xs];
+            }
+          for(xs=x0; xs<x1; xs++) dst[xs] = (double) acc[xs-x0];
+        }
+    }
+  res = 0;
+
+done:
+  free( (void *) kx );
+  free( (void *) ky );
+  free( (void *) sx );
+  free( (void *) sy );
+  free( (void *) cols );
+  free( (void *) rows );
+  free( (void *) aux );
+  free( (void *) work );
+  return res;
+}
+/*----------------------------------------------------------------------------*/
@@ -1,6 +1,10 @@
 #include <Rcpp.h>
 using namespace Rcpp;
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 extern "C" {
 #include "lsd.h"
 }
@@ -19,12 +23,19 @@ List detect_line_segments(NumericVector image, int X, int Y,
                           int union_use_NFA = 0,
                           double union_log_eps = 0.0,
                           double length_threshold = 5,
-                          double dist_threshold = 5)
+                          double dist_threshold = 5,
+                          int threads = 1)
 {
   int point_num = image.size();
   if (point_num != X * Y) {
     stop("Size of image not the same as X*Y");
   }
+  if (threads < 1) {
+    threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+  }
   int n_out, reg_x, reg_y;
   double * out;
   int * reg_img;
@@ -32,7 +43,7 @@ List detect_line_segments(NumericVector image, int X, int Y,
                               ang_th, log_eps, density_th, union_ang_th,
                               union_use_NFA, union_log_eps, n_bins,
                               need_to_union, &reg_img, &reg_x, &reg_y,
-                              length_threshold, dist_threshold );
+                              length_threshold, dist_threshold, threads );
 
   NumericMatrix y(n_out, 7);
   for(int i = 0; i < n_out; i++)
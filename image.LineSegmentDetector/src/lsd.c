@@ -80,6 +80,7 @@
 #include <limits.h>
 #include <float.h>
 #include "lsd.h"
+#include "gaussian_sampler.h"
 
 /** ln(10) */
 #ifndef M_LN10
@@ -114,15 +115,6 @@
 /** Label for pixels already used in detection. */
 #define USED    1
 
-/*----------------------------------------------------------------------------*/
-/** Chained list of coordinates.
- */
-struct coorlist
-{
-  int x,y;
-  struct coorlist * next;
-};
-
 /*----------------------------------------------------------------------------*/
 /** A point (or pixel).
  */
@@ -223,17 +215,6 @@ typedef struct ntuple_list_s
   double * values;
 } * ntuple_list;
 
-/*----------------------------------------------------------------------------*/
-/** Free memory used in n-tuple 'in'.
- */
-static void free_ntuple_list(ntuple_list in)
-{
-  if( in == NULL || in->values == NULL )
-    error("free_ntuple_list: invalid n-tuple input.");
-  free( (void *) in->values );
-  free( (void *) in );
-}
-
 /*----------------------------------------------------------------------------*/
 /** Create an n-tuple list and allocate memory for one element.
     @param dim the dimension (n) of the n-tuple.
@@ -397,17 +378,6 @@ typedef struct image_int_s
   unsigned int xsize,ysize;
 } * image_int;
 
-/*----------------------------------------------------------------------------*/
-/** Free memory used in image_int 'i'.
- */
-static void free_image_int(image_int i)
-{
-  if( i == NULL || i->data == NULL )
-    error("free_image_int: invalid input image.");
-  free( (void *) i->data );
-  free( (void *) i );
-}
-
 /*----------------------------------------------------------------------------*/
 
 /** Create a new image_int of size 'xsize' times 'ysize'.
@@ -529,39 +499,6 @@ static image_double new_image_double_ptr( unsigned int xsize,
 /*----------------------------- Gaussian filter ------------------------------*/
 /*----------------------------------------------------------------------------*/
 
-/*----------------------------------------------------------------------------*/
-/** Compute a Gaussian kernel of length 'kernel->dim',
-    standard deviation 'sigma', and centered at value 'mean'.
-
-    For example, if mean=0.5, the Gaussian will be centered
-    in the middle point between values 'kernel->values[0]'
-    and 'kernel->values[1]'.
- */
-static void gaussian_kernel(ntuple_list kernel, double sigma, double mean)
-{
-  double sum = 0.0;
-  double val;
-  unsigned int i;
-
-  /* check parameters */
-  if( kernel == NULL || kernel->values == NULL )
-    error("gaussian_kernel: invalid n-tuple 'kernel'.");
-  if( sigma <= 0.0 ) error("gaussian_kernel: 'sigma' must be positive.");
-
-  /* compute Gaussian kernel */
-  if( kernel->max_size < 1 ) enlarge_ntuple_list(kernel);
-  kernel->size = 1;
-  for(i=0;i<kernel->dim;i++)
-    {
-      val = ( (double) i - mean ) / sigma;
-      kernel->values[i] = exp( -0.5 * val * val );
-      sum += kernel->values[i];
-    }
-
-  /* normalization */
-  if( sum >= 0.0 ) for(i=0;i<kernel->dim;i++) kernel->values[i] /= sum;
-}
-
 /*----------------------------------------------------------------------------*/
 /** Scale the input image 'in' by a factor 'scale' by Gaussian sub-sampling.
 
@@ -598,16 +535,15 @@ static void gaussian_kernel(ntuple_list kernel, double sigma, double mean)
     @f]
     The algorithm first applies a combined Gaussian kernel and sampling
     in the x axis, and then the combined Gaussian kernel and sampling
-    in the y axis.
+    in the y axis. Both passes are done by gaussian_sampler_data(),
+    row by row and in single precision, with 'threads' threads.
  */
 static image_double gaussian_sampler( image_double in, double scale,
-                                      double sigma_scale )
+                                      double sigma_scale, int threads )
 {
-  image_double aux,out;
-  ntuple_list kernel;
-  unsigned int N,M,h,n,x,y,i;
-  int xc,yc,j,double_x_size,double_y_size;
-  double sigma,xx,yy,sum,prec;
+  image_double out;
+  unsigned int N,M;
+  double sigma;
 
   /* check parameters */
   if( in == NULL || in->data == NULL || in->xsize == 0 || in->ysize == 0 )
@@ -617,104 +553,19 @@ static image_double gaussian_sampler( image_double in, double scale,
     error("gaussian_sampler: 'sigma_scale' must be positive.");
 
   /* compute new image size and get memory for images */
-  if( in->xsize * scale > (double) UINT_MAX ||
-      in->ysize * scale > (double) UINT_MAX )
+  if( in->xsize * scale > (double) INT_MAX ||
+      in->ysize * scale > (double) INT_MAX )
     error("gaussian_sampler: the output image size exceeds the handled size.");
   N = (unsigned int) ceil( in->xsize * scale );
   M = (unsigned int) ceil( in->ysize * scale );
-  aux = new_image_double(N,in->ysize);
   out = new_image_double(N,M);
 
-  /* sigma, kernel size and memory for the kernel */
+  /* sigma */
   sigma = scale < 1.0 ? sigma_scale / scale : sigma_scale;
-  /*
-     The size of the kernel is selected to guarantee that the
-     the first discarded term is at least 10^prec times smaller
-     than the central value. For that, h should be larger than x, with
-       e^(-x^2/2sigma^2) = 1/10^prec.
-     Then,
-       x = sigma * sqrt( 2 * prec * ln(10) ).
-   */
-  prec = 3.0;
-  h = (unsigned int) ceil( sigma * sqrt( 2.0 * prec * log(10.0) ) );
-  n = 1+2*h; /* kernel size */
-  kernel = new_ntuple_list(n);
 
-  /* auxiliary double image size variables */
-  double_x_size = (int) (2 * in->xsize);
-  double_y_size = (int) (2 * in->ysize);
-
-  /* First subsampling: x axis */
-  for(x=0;x<aux->xsize;x++)
-    {
-      /*
-         x   is the coordinate in the new image.
-         xx  is the corresponding x-value in the original size image.
-         xc  is the integer value, the pixel coordinate of xx.
-       */
-      xx = (double) x / scale;
-      /* coordinate (0.0,0.0) is in the center of pixel (0,0),
-         so the pixel with xc=0 get the values of xx from -0.5 to 0.5 */
-      xc = (int) floor( xx + 0.5 );
-      gaussian_kernel( kernel, sigma, (double) h + xx - (double) xc );
-      /* the kernel must be computed for each x because the fine
-         offset xx-xc is different in each case */
-
-      for(y=0;y<aux->ysize;y++)
-        {
-          sum = 0.0;
-          for(i=0;i<kernel->dim;i++)
-            {
-              j = xc - h + i;
-
-              /* symmetry boundary condition */
-              while( j < 0 ) j += double_x_size;
-              while( j >= double_x_size ) j -= double_x_size;
-              if( j >= (int) in->xsize ) j = double_x_size-1-j;
-
-              sum += in->data[ j + y * in->xsize ] * kernel->values[i];
-            }
-          aux->data[ x + y * aux->xsize ] = sum;
-        }
-    }
-
-  /* Second subsampling: y axis */
-  for(y=0;y<out->ysize;y++)
-    {
-      /*
-         y   is the coordinate in the new image.
-         yy  is the corresponding x-value in the original size image.
-         yc  is the integer value, the pixel coordinate of xx.
-       */
-      yy = (double) y / scale;
-      /* coordinate (0.0,0.0) is in the center of pixel (0,0),
-         so the pixel with yc=0 get the values of yy from -0.5 to 0.5 */
-      yc = (int) floor( yy + 0.5 );
-      gaussian_kernel( kernel, sigma, (double) h + yy - (double) yc );
-      /* the kernel must be computed for each y because the fine
-         offset yy-yc is different in each case */
-
-      for(x=0;x<out->xsize;x++)
-        {
-          sum = 0.0;
-          for(i=0;i<kernel->dim;i++)
-            {
-              j = yc - h + i;
-
-              /* symmetry boundary condition */
-              while( j < 0 ) j += double_y_size;
-              while( j >= double_y_size ) j -= double_y_size;
-              if( j >= (int) in->ysize ) j = double_y_size-1-j;
-
-              sum += aux->data[ x + j * aux->xsize ] * kernel->values[i];
-            }
-          out->data[ x + y * out->xsize ] = sum;
-        }
-    }
-
-  /* free memory */
-  free_ntuple_list(kernel);
-  free_image_double(aux);
+  if( gaussian_sampler_data( in->data, (int) in->xsize, (int) in->ysize,
+                             out->data, scale, sigma, threads ) != 0 )
+    error("gaussian_sampler: not enough memory.");
 
   return out;
 }
@@ -731,45 +582,41 @@ static image_double gaussian_sampler( image_double in, double scale,
     - an image_double with the angle at each pixel, or NOTDEF if not defined.
     - the image_double 'modgrad' (a pointer is passed as argument)
       with the gradient magnitude at each point.
-    - a list of pixels 'list_p' roughly ordered by decreasing
-      gradient magnitude. (The order is made by classifying points
-      into bins by gradient magnitude. The parameters 'n_bins' and
-      'max_grad' specify the number of bins and the gradient modulus
-      at the highest bin. The pixels in the list would be in
-      decreasing gradient magnitude, up to a precision of the size of
-      the bins.)
-    - a pointer 'mem_p' to the memory used by 'list_p' to be able to
-      free the memory when it is not used anymore.
+    - an array 'order' with the index x+y*xsize of the 'n_order' pixels
+      of defined angle, roughly ordered by decreasing gradient magnitude.
+      (The order is made by classifying points into bins by gradient
+      magnitude. The parameters 'n_bins' and 'max_grad' specify the number
+      of bins and the gradient modulus at the highest bin. The pixels in
+      the array would be in decreasing gradient magnitude, up to a
+      precision of the size of the bins. Within a bin, the pixels are
+      ordered by column and then by row.)
+
+    The rows are processed by 'threads' threads.
  */
 static image_double ll_angle( image_double in, double threshold,
-                              struct coorlist ** list_p, void ** mem_p,
-                              image_double * modgrad, unsigned int n_bins )
+                              int ** order, int * n_order,
+                              image_double * modgrad, unsigned int n_bins,
+                              int threads )
 {
   image_double g;
-  unsigned int n,p,x,y,adr,i;
-  double com1,com2,gx,gy,norm,norm2;
-  /* the rest of the variables are used for pseudo-ordering
-     the gradient magnitude values */
-  int list_count = 0;
-  struct coorlist * list;
-  struct coorlist ** range_l_s; /* array of pointers to start of bin list */
-  struct coorlist ** range_l_e; /* array of pointers to end of bin list */
-  struct coorlist * start;
-  struct coorlist * end;
+  int n,p,x,y,adr,i;
+  int * bin;   /* for each pixel, its bin counted from the highest one */
+  int * first; /* index in 'order' of the first pixel of each bin */
+  int count = 0;
   double max_grad = 0.0;
 
   /* check parameters */
   if( in == NULL || in->data == NULL || in->xsize == 0 || in->ysize == 0 )
     error("ll_angle: invalid image.");
   if( threshold < 0.0 ) error("ll_angle: 'threshold' must be positive.");
-  if( list_p == NULL ) error("ll_angle: NULL pointer 'list_p'.");
-  if( mem_p == NULL ) error("ll_angle: NULL pointer 'mem_p'.");
+  if( order == NULL ) error("ll_angle: NULL pointer 'order'.");
+  if( n_order == NULL ) error("ll_angle: NULL pointer 'n_order'.");
   if( modgrad == NULL ) error("ll_angle: NULL pointer 'modgrad'.");
   if( n_bins == 0 ) error("ll_angle: 'n_bins' must be positive.");
 
   /* image size shortcuts */
-  n = in->ysize;
-  p = in->xsize;
+  n = (int) in->ysize;
+  p = (int) in->xsize;
 
   /* allocate output image */
   g = new_image_double(in->xsize,in->ysize);
@@ -777,104 +624,95 @@ static image_double ll_angle( image_double in, double threshold,
   /* get memory for the image of gradient modulus */
   *modgrad = new_image_double(in->xsize,in->ysize);
 
-  /* get memory for "ordered" list of pixels */
-  list = (struct coorlist *) calloc( (size_t) (n*p), sizeof(struct coorlist) );
-  *mem_p = (void *) list;
-  range_l_s = (struct coorlist **) calloc( (size_t) n_bins,
-                                           sizeof(struct coorlist *) );
-  range_l_e = (struct coorlist **) calloc( (size_t) n_bins,
-                                           sizeof(struct coorlist *) );
-  if( list == NULL || range_l_s == NULL || range_l_e == NULL )
-    error("not enough memory.");
-  for(i=0;i<n_bins;i++) range_l_s[i] = range_l_e[i] = NULL;
+  /* get memory for the bins */
+  bin = (int *) malloc( (size_t) n * (size_t) p * sizeof(int) );
+  first = (int *) calloc( (size_t) n_bins + 1, sizeof(int) );
+  if( bin == NULL || first == NULL ) error("not enough memory.");
 
   /* 'undefined' on the down and right boundaries */
   for(x=0;x<p;x++) g->data[(n-1)*p+x] = NOTDEF;
   for(y=0;y<n;y++) g->data[p*y+p-1]   = NOTDEF;
 
-  /* compute gradient on the remaining pixels */
-  for(x=0;x<p-1;x++)
-    for(y=0;y<n-1;y++)
-      {
-        adr = y*p+x;
+  /* compute gradient on the remaining pixels, row by row */
+#pragma omp parallel for schedule(static) num_threads(threads) reduction(max:max_grad)
+  for(y=0;y<n-1;y++)
+    {
+      const double * row = in->data + (size_t) y * p;
+      const double * next = row + p;
+      double * norm = (*modgrad)->data + (size_t) y * p;
+      double * angle = g->data + (size_t) y * p;
+      double com1,com2,gx,gy;
+      int xx;
 
-        /*
-           Norm 2 computation using 2x2 pixel window:
-             A B
-             C D
-           and
-             com1 = D-A,  com2 = B-C.
-           Then
-             gx = B+D - (A+C)   horizontal difference
-             gy = C+D - (A+B)   vertical difference
-           com1 and com2 are just to avoid 2 additions.
-         */
-        com1 = in->data[adr+p+1] - in->data[adr];
-        com2 = in->data[adr+1]   - in->data[adr+p];
-
-        gx = com1+com2; /* gradient x component */
-        gy = com1-com2; /* gradient y component */
-        norm2 = gx*gx+gy*gy;
-        norm = sqrt( norm2 / 4.0 ); /* gradient norm */
-
-        (*modgrad)->data[adr] = norm; /* store gradient norm */
-
-        if( norm <= threshold ) /* norm too small, gradient no defined */
-          g->data[adr] = NOTDEF; /* gradient angle not defined */
+      /*
+         Norm 2 computation using 2x2 pixel window:
+           A B
+           C D
+         and
+           com1 = D-A,  com2 = B-C.
+         Then
+           gx = B+D - (A+C)   horizontal difference
+           gy = C+D - (A+B)   vertical difference
+         com1 and com2 are just to avoid 2 additions.
+       */
+#pragma omp simd private(com1,com2,gx,gy)
+      for(xx=0;xx<p-1;xx++)
+        {
+          com1 = next[xx+1] - row[xx];
+          com2 = row[xx+1]  - next[xx];
+          gx = com1+com2; /* gradient x component */
+          gy = com1-com2; /* gradient y component */
+          norm[xx] = sqrt( (gx*gx+gy*gy) / 4.0 ); /* gradient norm */
+        }
+
+      /* the angle is only computed where the norm is large enough */
+      for(xx=0;xx<p-1;xx++)
+        if( norm[xx] <= threshold ) /* norm too small, gradient no defined */
+          angle[xx] = NOTDEF; /* gradient angle not defined */
         else
           {
-            /* gradient angle computation */
-            g->data[adr] = atan2(gx,-gy);
+            com1 = next[xx+1] - row[xx];
+            com2 = row[xx+1]  - next[xx];
+            angle[xx] = atan2(com1+com2,-(com1-com2));
 
             /* look for the maximum of the gradient */
-            if( norm > max_grad ) max_grad = norm;
+            if( norm[xx] > max_grad ) max_grad = norm[xx];
           }
-      }
+    }
 
-  /* compute histogram of gradient values */
-  for(x=0;x<p-1;x++)
-    for(y=0;y<n-1;y++)
+  /* classify the points of defined angle into bins of gradient values,
+     from the highest bin to the lowest */
+  for(y=0;y<n-1;y++)
+    for(x=0;x<p-1;x++)
       {
-        norm = (*modgrad)->data[y*p+x];
-
-        /* store the point in the right bin according to its norm */
-        i = (unsigned int) (norm * (double) n_bins / max_grad);
-        if( i >= n_bins ) i = n_bins-1;
-        if( range_l_e[i] == NULL )
-          range_l_s[i] = range_l_e[i] = list+list_count++;
-        else
+        adr = y*p+x;
+        if( g->data[adr] == NOTDEF )
           {
-            range_l_e[i]->next = list+list_count;
-            range_l_e[i] = list+list_count++;
+            bin[adr] = -1;
+            continue;
           }
-        range_l_e[i]->x = (int) x;
-        range_l_e[i]->y = (int) y;
-        range_l_e[i]->next = NULL;
+        i = (int) ( (*modgrad)->data[adr] * (double) n_bins / max_grad );
+        if( i >= (int) n_bins ) i = n_bins-1;
+        bin[adr] = n_bins-1-i;
+        ++first[bin[adr]+1];
+        ++count;
       }
+  for(i=0;i<(int)n_bins;i++) first[i+1] += first[i];
 
-  /* Make the list of pixels (almost) ordered by norm value.
-     It starts by the larger bin, so the list starts by the
-     pixels with the highest gradient value. Pixels would be ordered
-     by norm value, up to a precision given by max_grad/n_bins.
+  /* Make the array of pixels (almost) ordered by norm value, by a
+     counting sort that keeps the pixels of a bin by column and row.
    */
-  for(i=n_bins-1; i>0 && range_l_s[i]==NULL; i--);
-  start = range_l_s[i];
-  end = range_l_e[i];
-  if( start != NULL )
-    while(i>0)
-      {
-        --i;
-        if( range_l_s[i] != NULL )
-          {
-            end->next = range_l_s[i];
-            end = range_l_e[i];
-          }
-      }
-  *list_p = start;
+  *order = (int *) malloc( (size_t) (count+1) * sizeof(int) );
+  if( *order == NULL ) error("not enough memory.");
+  for(x=0;x<p-1;x++)
+    for(y=0;y<n-1;y++)
+      if( bin[y*p+x] >= 0 )
+        (*order)[ first[bin[y*p+x]]++ ] = y*p+x;
+  *n_order = count;
 
   /* free memory */
-  free( (void *) range_l_s );
-  free( (void *) range_l_e );
+  free( (void *) bin );
+  free( (void *) first );
 
   return g;
 }
@@ -1026,11 +864,6 @@ static double log_gamma_windschitl(double x)
  */
 #define log_gamma(x) ((x)>15.0?log_gamma_windschitl(x):log_gamma_lanczos(x))
 
-/*----------------------------------------------------------------------------*/
-/** Size of the table to store already computed inverse values.
- */
-#define TABSIZE 100000
-
 /*----------------------------------------------------------------------------*/
 /** Computes -log10(NFA).
 
@@ -1075,7 +908,6 @@ static double log_gamma_windschitl(double x)
  */
 static double nfa(int n, int k, double p, double logNT)
 {
-  static double inv[TABSIZE];   /* table to keep computed inverse values */
   double tolerance = 0.1;       /* an error of 10% in the result is accepted */
   double log1term,term,bin_term,mult_term,bin_tail,err,p_term;
   int i;
@@ -1126,13 +958,11 @@ static double nfa(int n, int k, double p, double logNT)
            term_i / term_i-1 = (n-i+1)/i * p/(1-p)
          and
            term_i = term_i-1 * (n-i+1)/i * p/(1-p).
-         1/i is stored in a table as they are computed,
-         because divisions are expensive.
          p/(1-p) is computed only once and stored in 'p_term'.
+         1/i is not kept in a table shared between calls, as nfa() is
+         called concurrently by the bands of band_segment_detection().
        */
-      bin_term = (double) (n-i+1) * ( i<TABSIZE ?
-                   ( inv[i]!=0.0 ? inv[i] : ( inv[i] = 1.0 / (double) i ) ) :
-                   1.0 / (double) i );
+      bin_term = (double) (n-i+1) * ( 1.0 / (double) i );
 
       mult_term = bin_term * p_term;
       term *= mult_term;
@@ -2224,13 +2054,150 @@ static void rects2rect( int * reg, int reg_size,
 
 
 
+/*----------------------------------------------------------------------------*/
+/** Uniform grid over the end points of the line segments.
+
+    Two segments can only be united when an end point of one is within
+    'dist_threshold' of an end point of the other (see rect_distance), so
+    the candidates to join a segment are found in the cells around its end
+    points instead of among all the segments. Cell 'c' holds the indices of
+    the segments with an end point in it, in increasing order, in
+    seg[start[c]] .. seg[start[c+1]-1].
+ */
+struct segment_grid
+{
+  int nx,ny;     /* number of cells in x and y */
+  int r;         /* number of neighbouring cells to search in each direction */
+  double cell;   /* cell size */
+  int * start;
+  int * seg;
+  int * mark;    /* per segment, the last query that returned it */
+  int query;
+};
+
+/*----------------------------------------------------------------------------*/
+/** Cell of coordinate 'v', end points outside the image go to the border.
+ */
+static int grid_cell(double v, double cell, int n)
+{
+  int c = (int) floor( v / cell );
+  if( c < 0 ) c = 0;
+  if( c >= n ) c = n-1;
+  return c;
+}
+
+/*----------------------------------------------------------------------------*/
+/** Bucket the end points of the n segments in a grid over an image of size
+    xsize x ysize. The cells are at least 'dist_threshold' wide and there are
+    at most about 4n of them.
+ */
+static void new_segment_grid( struct segment_grid * g, struct rect * points,
+                              int n, unsigned int xsize, unsigned int ysize,
+                              double dist_threshold )
+{
+  int i,j,c1,c2,ncell;
+  double min_cell = sqrt( (double) xsize * (double) ysize / (4.0 * n + 1.0) );
+
+  g->cell = dist_threshold > min_cell ? dist_threshold : min_cell;
+  if( g->cell < 1.0 ) g->cell = 1.0;
+  g->nx = (int) ceil( xsize / g->cell );
+  g->ny = (int) ceil( ysize / g->cell );
+  if( g->nx < 1 ) g->nx = 1;
+  if( g->ny < 1 ) g->ny = 1;
+  g->r = (int) ceil( dist_threshold / g->cell );
+  ncell = g->nx * g->ny;
+
+  g->start = (int *) calloc( (size_t) (ncell+1), sizeof(int) );
+  g->seg = (int *) malloc( (size_t) (2*n+1) * sizeof(int) );
+  g->mark = (int *) calloc( (size_t) (n+1), sizeof(int) );
+  if( g->start == NULL || g->seg == NULL || g->mark == NULL )
+    error("not enough memory.");
+  g->query = 0;
+
+  /* counting sort of the segments by cell, a segment with both end points
+     in the same cell is stored once */
+  for(i=0; i<n; i++)
+    {
+      c1 = grid_cell(points[i].x1, g->cell, g->nx)
+         + grid_cell(points[i].y1, g->cell, g->ny) * g->nx;
+      c2 = grid_cell(points[i].x2, g->cell, g->nx)
+         + grid_cell(points[i].y2, g->cell, g->ny) * g->nx;
+      ++g->start[c1+1];
+      if( c2 != c1 ) ++g->start[c2+1];
+    }
+  for(c1=0; c1<ncell; c1++) g->start[c1+1] += g->start[c1];
+  for(i=0; i<n; i++)
+    {
+      c1 = grid_cell(points[i].x1, g->cell, g->nx)
+         + grid_cell(points[i].y1, g->cell, g->ny) * g->nx;
+      c2 = grid_cell(points[i].x2, g->cell, g->nx)
+         + grid_cell(points[i].y2, g->cell, g->ny) * g->nx;
+      g->seg[g->start[c1]++] = i;
+      if( c2 != c1 ) g->seg[g->start[c2]++] = i;
+    }
+  /* the fill moved every start to the start of the next cell */
+  for(j=ncell; j>0; j--) g->start[j] = g->start[j-1];
+  g->start[0] = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/** Free memory used in the segment grid.
+ */
+static void free_segment_grid(struct segment_grid * g)
+{
+  free( (void *) g->start );
+  free( (void *) g->seg );
+  free( (void *) g->mark );
+}
+
+/*----------------------------------------------------------------------------*/
+/** Add to 'cand' the segments with an end point in the cells around (x,y).
+ */
+static void grid_neighbours( struct segment_grid * g, double x, double y,
+                             int * cand, int * n_cand )
+{
+  int cx = grid_cell(x, g->cell, g->nx);
+  int cy = grid_cell(y, g->cell, g->ny);
+  int i,j,k,c;
+
+  for(j=cy-g->r; j<=cy+g->r; j++)
+    for(i=cx-g->r; i<=cx+g->r; i++)
+      {
+        if( i < 0 || j < 0 || i >= g->nx || j >= g->ny ) continue;
+        c = i + j * g->nx;
+        for(k=g->start[c]; k<g->start[c+1]; k++)
+          if( g->mark[g->seg[k]] != g->query )
+            {
+              g->mark[g->seg[k]] = g->query;
+              cand[(*n_cand)++] = g->seg[k];
+            }
+      }
+}
+
+/*----------------------------------------------------------------------------*/
+/** Compare integers, to be used with qsort.
+ */
+static int comp_int(const void * a, const void * b)
+{
+  return *(const int *) a - *(const int *) b;
+}
+
+/*----------------------------------------------------------------------------*/
+/** Unite the segments that continue the segment 'init_ind' into a region.
+
+    The candidates to join a member of the region are taken from the grid and
+    tried in increasing index, as a scan over all the segments would do, so
+    the region and its angle do not depend on the grid. 'cand' is scratch
+    memory for n segments.
+ */
 static void g_region_grow( int init_ind, int * reg,
                          int * reg_size, double * reg_angle, int * used,
                          struct rect *points, int n, double prec, double dist_threshold,
-                         double length_threshold )
+                         double length_threshold, struct segment_grid * grid,
+                         int * cand )
 {
   double sumdx,sumdy, dx, dy;
-  int i, j, a=1, b=1;
+  int i, j, k, n_cand, a=1, b=1;
   //struct rect *init_point = &points[init_ind];
 
   /* first points of the region */
@@ -2242,11 +2209,19 @@ static void g_region_grow( int init_ind, int * reg,
   used[init_ind] = USED;
 
   /* try neighbors */
-  for(i = 0; i<*reg_size; i++)
-    for(j = 0; j < n; j++) {
-      if (used[j] != USED &&
+  for(i = 0; i<*reg_size; i++) {
+    /* segments with an end point close to the end points of reg[i] */
+    n_cand = 0;
+    ++grid->query;
+    grid_neighbours(grid, points[reg[i]].x1, points[reg[i]].y1, cand, &n_cand);
+    grid_neighbours(grid, points[reg[i]].x2, points[reg[i]].y2, cand, &n_cand);
+    qsort(cand, (size_t) n_cand, sizeof(int), comp_int);
+
+    for(k = 0; k < n_cand; k++) {
+      j = cand[k];
+      /* the angle test is cheaper than the distance, it comes first */
+      if (used[j] != USED && isaligned_(points[j].theta, *reg_angle, prec) &&
         rect_distance(&points[reg[i]], &points[j], dist_threshold + 1, &a, &b) <= dist_threshold) {
-            if (isaligned_(points[j].theta, *reg_angle, prec)) {
                 /* add neighbor */
                 used[j] = USED;
                 reg[*reg_size] = j;
@@ -2262,15 +2237,10 @@ static void g_region_grow( int init_ind, int * reg,
                 sumdx += dx;
                 sumdy += dy;
                 *reg_angle = atan2(sumdy,sumdx);
-            }
         }
     }
   }
-
-
-
-
-
+}
 
 
 int comp_rect_len(const void *a, const void *b)
@@ -2303,14 +2273,16 @@ void line_segment_grower(double * img, int X, int Y,
 {
   int *used;
   struct rect rec;
+  struct segment_grid grid;
+  int * cand;
   int * reg;
   //int reg_size, i, j;
   int reg_size, j;
   double reg_angle,prec,p,log_nfa=log_eps,logNT;
   int ls_count = 0;                   /* line segments are numbered 1,2,3,... */
 
-  free( (void *) out );
-  out = new_ntuple_list(7);
+  /* the united segments replace the detected ones in 'out' */
+  out->size = 0;
 
   /* angle tolerance */
   prec = M_PI * ang_th / 180.0;
@@ -2337,12 +2309,15 @@ void line_segment_grower(double * img, int X, int Y,
 
 
   /* initialize some structures */
-  used = calloc(size, sizeof(used[0]));
-  reg = (int *) calloc( size, sizeof(reg[0]) );
-  if( reg == NULL ) error("not enough memory!");
-  if ( reg_img != NULL && reg_x != NULL && reg_y != NULL ) {
-      free_image_int(region);
-      region = new_image_int_ini(image->xsize,image->ysize,0);
+  used = calloc(size + 1, sizeof(used[0]));
+  reg = (int *) calloc( size + 1, sizeof(reg[0]) );
+  cand = (int *) malloc( (size + 1) * sizeof(cand[0]) );
+  if( used == NULL || reg == NULL || cand == NULL ) error("not enough memory!");
+  new_segment_grid(&grid, points, size, xsize, ysize, dist_threshold);
+  if ( reg_img != NULL && reg_x != NULL && reg_y != NULL && region != NULL ) {
+      /* the united segments are not labelled in the region image */
+      unsigned int N = region->xsize * region->ysize, i;
+      for(i=0; i<N; i++) region->data[i] = 0;
   }
 
   /* search for line segments */
@@ -2351,7 +2326,7 @@ void line_segment_grower(double * img, int X, int Y,
         /* find the ~ connected segments */
         g_region_grow(j, reg, &reg_size,
                      &reg_angle, used, points, size,
-                     prec, dist_threshold, length_threshold );
+                     prec, dist_threshold, length_threshold, &grid, cand );
 
         /* construct rectangular approximation for the region */
         rects2rect(reg,reg_size,points,reg_angle,prec,p,&rec);
@@ -2391,6 +2366,8 @@ void line_segment_grower(double * img, int X, int Y,
   /* free memory */
   free(used);
   free( (void *) reg );
+  free( (void *) cand );
+  free_segment_grid(&grid);
 
 }
 
@@ -2401,6 +2378,254 @@ void line_segment_grower(double * img, int X, int Y,
 /*-------------------------- Line Segment Detector ---------------------------*/
 /*----------------------------------------------------------------------------*/
 
+/*----------------------------------------------------------------------------*/
+/** Grow, refine and validate the line segment seeded at pixel (x,y).
+
+    Returns TRUE when a meaningful segment is found. Its rectangle is then
+    in 'rec', its -log10(NFA) in 'log_nfa' and its pixels in 'reg'.
+ */
+static int seed_segment( int x, int y, image_double angles,
+                         image_double modgrad, image_char used,
+                         struct point * reg, int * reg_size, int min_reg_size,
+                         double prec, double p, double logNT, double log_eps,
+                         double density_th, struct rect * rec, double * log_nfa )
+{
+  double reg_angle;
+
+  /* find the region of connected point and ~equal angle */
+  region_grow( x, y, angles, reg, reg_size, &reg_angle, used, prec );
+
+  /* reject small regions */
+  if( *reg_size < min_reg_size ) return FALSE;
+
+  /* construct rectangular approximation for the region */
+  region2rect(reg,*reg_size,modgrad,reg_angle,prec,p,rec);
+
+  /* Check if the rectangle exceeds the minimal density of
+     region points. If not, try to improve the region.
+     The rectangle will be rejected if the final one does
+     not fulfill the minimal density condition.
+     This is an addition to the original LSD algorithm published in
+     "LSD: A Fast Line Segment Detector with a False Detection Control"
+     by R. Grompone von Gioi, J. Jakubowicz, J.M. Morel, and G. Randall.
+     The original algorithm is obtained with density_th = 0.0.
+   */
+  if( !refine( reg, reg_size, modgrad, reg_angle,
+               prec, p, rec, used, angles, density_th ) ) return FALSE;
+
+  /* compute NFA value */
+  *log_nfa = rect_improve(rec,angles,logNT,log_eps);
+  return *log_nfa > log_eps;
+}
+
+/*----------------------------------------------------------------------------*/
+/** Add a line segment found to the output and to the rectangles used by
+    the union of segments.
+ */
+static void add_segment( ntuple_list out, struct rect ** rects, int * rects_u,
+                         int * rects_a, struct rect rec, double log_nfa,
+                         double scale )
+{
+  /*
+     The gradient was computed with a 2x2 mask, its value corresponds to
+     points with an offset of (0.5,0.5), that should be added to output.
+     The coordinates origin is at the center of pixel (0,0).
+   */
+  rec.x1 += 0.5; rec.y1 += 0.5;
+  rec.x2 += 0.5; rec.y2 += 0.5;
+
+  rec.length = sqrt((rec.x1 - rec.x2) * (rec.x1 - rec.x2) + (rec.y1 - rec.y2) * (rec.y1 - rec.y2));
+  rec.x1 = (int) rec.x1;
+  rec.y1 = (int) rec.y1;
+  rec.x2 = (int) rec.x2;
+  rec.y2 = (int) rec.y2;
+  if (*rects_a <= *rects_u) {
+      if (!*rects_a) {
+          *rects_a = 32;
+      }
+      *rects_a *= 2;
+      *rects = realloc(*rects, *rects_a * sizeof(struct rect));
+  }
+  (*rects)[(*rects_u)++] = rec;
+
+  /* scale the result values if a subsampling was performed */
+  if( scale != 1.0 )
+    {
+      rec.x1 /= scale; rec.y1 /= scale;
+      rec.x2 /= scale; rec.y2 /= scale;
+      rec.width /= scale;
+    }
+
+  /* add line segment found to output */
+  add_7tuple( out, rec.x1, rec.y1, rec.x2, rec.y2,
+                   rec.width, rec.p, log_nfa );
+}
+
+/*----------------------------------------------------------------------------*/
+/** Minimal number of rows of a band in the multi-threaded search.
+ */
+#define BAND_MIN_ROWS 32
+
+/*----------------------------------------------------------------------------*/
+/** A line segment found in a band, with the rank of its seed in the
+    pseudo-ordered pixels and its region pts[start..start+size-1]
+    in the points of the band.
+ */
+struct band_segment
+{
+  struct rect rec;
+  double log_nfa;
+  int rank,band,start,size;
+};
+
+/*----------------------------------------------------------------------------*/
+/** The line segments found in a band of rows and their regions.
+ */
+struct segment_band
+{
+  struct band_segment * seg;
+  int n_seg,max_seg;
+  struct point * pts;
+  int n_pts,max_pts;
+};
+
+/*----------------------------------------------------------------------------*/
+/** Compare band segments by the rank of their seed.
+ */
+static int comp_band_segment(const void * a, const void * b)
+{
+  const struct band_segment * sa = *(const struct band_segment * const *) a;
+  const struct band_segment * sb = *(const struct band_segment * const *) b;
+  return sa->rank - sb->rank;
+}
+
+/*----------------------------------------------------------------------------*/
+/** Search line segments in 'bands' horizontal bands of rows in parallel.
+
+    Each band takes as seeds the pixels of its own rows, in the order of
+    'order', and grows regions over the whole image with its own 'used' map.
+    A segment crossing the border of two bands can thus be found by both.
+    The segments of all bands are then taken in the order of their seed, as
+    the single-threaded search would, and a segment is dropped when more
+    than half of its region was already claimed by the segments kept before
+    it. The result depends on the number of bands but not on the scheduling
+    of the threads.
+ */
+static void band_segment_detection( int bands, int * order, int n_order,
+                                    image_double angles, image_double modgrad,
+                                    image_char used, image_int region,
+                                    ntuple_list out, struct rect ** rects,
+                                    int * rects_u, int * rects_a,
+                                    int min_reg_size, double prec, double p,
+                                    double logNT, double log_eps,
+                                    double density_th, double scale )
+{
+  unsigned int xsize = angles->xsize;
+  unsigned int ysize = angles->ysize;
+  struct segment_band * band;
+  struct band_segment ** all;
+  int n_all = 0, ls_count = 0;
+  int b,i,k,shared;
+
+  band = (struct segment_band *) calloc( (size_t) bands,
+                                         sizeof(struct segment_band) );
+  if( band == NULL ) error("not enough memory.");
+
+  /* a region only holds pixels of defined angle, at most n_order */
+#pragma omp parallel for schedule(dynamic) num_threads(bands)
+  for(b=0; b<bands; b++)
+    {
+      struct segment_band * sb = band + b;
+      /* the pixels of the rows of the band */
+      int adr0 = (int) ( (long long) b * ysize / bands ) * (int) xsize;
+      int adr1 = (int) ( (long long) (b+1) * ysize / bands ) * (int) xsize;
+      image_char band_used = new_image_char_ini(xsize,ysize,NOTUSED);
+      struct point * reg = (struct point *) malloc( (size_t) (n_order+1) *
+                                                    sizeof(struct point) );
+      struct rect rec;
+      double log_nfa;
+      int j,m,reg_size;
+
+      if( reg == NULL ) error("not enough memory.");
+      for(j=0; j<n_order; j++)
+        {
+          if( order[j] < adr0 || order[j] >= adr1 ) continue;
+          if( band_used->data[ order[j] ] != NOTUSED ) continue;
+          if( !seed_segment( order[j] % (int) xsize, order[j] / (int) xsize,
+                             angles, modgrad, band_used, reg, &reg_size,
+                             min_reg_size, prec, p, logNT, log_eps,
+                             density_th, &rec, &log_nfa ) ) continue;
+
+          /* keep the segment and its region */
+          if( sb->n_seg == sb->max_seg )
+            {
+              sb->max_seg = sb->max_seg ? 2 * sb->max_seg : 64;
+              sb->seg = (struct band_segment *)
+                realloc( (void *) sb->seg,
+                         sb->max_seg * sizeof(struct band_segment) );
+              if( sb->seg == NULL ) error("not enough memory.");
+            }
+          while( sb->n_pts + reg_size > sb->max_pts )
+            {
+              sb->max_pts = sb->max_pts ? 2 * sb->max_pts : 4096;
+              sb->pts = (struct point *)
+                realloc( (void *) sb->pts, sb->max_pts * sizeof(struct point) );
+              if( sb->pts == NULL ) error("not enough memory.");
+            }
+          sb->seg[sb->n_seg].rec = rec;
+          sb->seg[sb->n_seg].log_nfa = log_nfa;
+          sb->seg[sb->n_seg].rank = j;
+          sb->seg[sb->n_seg].band = b;
+          sb->seg[sb->n_seg].start = sb->n_pts;
+          sb->seg[sb->n_seg].size = reg_size;
+          ++sb->n_seg;
+          for(m=0; m<reg_size; m++) sb->pts[sb->n_pts++] = reg[m];
+        }
+      free( (void *) reg );
+      free_image_char(band_used);
+    }
+
+  /* take the segments of all bands in the order of their seed */
+  for(b=0; b<bands; b++) n_all += band[b].n_seg;
+  all = (struct band_segment **) malloc( (size_t) (n_all+1) *
+                                         sizeof(struct band_segment *) );
+  if( all == NULL ) error("not enough memory.");
+  for(b=0, n_all=0; b<bands; b++)
+    for(i=0; i<band[b].n_seg; i++) all[n_all++] = band[b].seg + i;
+  qsort( (void *) all, (size_t) n_all, sizeof(struct band_segment *),
+         comp_band_segment );
+
+  for(i=0; i<n_all; i++)
+    {
+      struct point * pts = band[all[i]->band].pts + all[i]->start;
+
+      /* drop the duplicates of segments already kept */
+      for(k=0, shared=0; k<all[i]->size; k++)
+        if( used->data[ pts[k].x + pts[k].y * xsize ] == USED ) ++shared;
+      if( 2 * shared > all[i]->size ) continue;
+
+      ++ls_count;
+      for(k=0; k<all[i]->size; k++)
+        if( used->data[ pts[k].x + pts[k].y * xsize ] != USED )
+          {
+            used->data[ pts[k].x + pts[k].y * xsize ] = USED;
+            if( region != NULL )
+              region->data[ pts[k].x + pts[k].y * xsize ] = ls_count;
+          }
+      add_segment( out, rects, rects_u, rects_a,
+                   all[i]->rec, all[i]->log_nfa, scale );
+    }
+
+  /* free memory */
+  for(b=0; b<bands; b++)
+    {
+      free( (void *) band[b].seg );
+      free( (void *) band[b].pts );
+    }
+  free( (void *) band );
+  free( (void *) all );
+}
+
 /*----------------------------------------------------------------------------*/
 /** LSD full interface.
  */
@@ -2411,7 +2636,8 @@ double * LineSegmentDetection( int * n_out,
                                double union_ang_th, int union_use_NFA, double union_log_eps,
                                int n_bins, int need_to_union,
                                int ** reg_img, int * reg_x, int * reg_y,
-                               double length_threshold, double dist_threshold )
+                               double length_threshold, double dist_threshold,
+                               int threads )
 {
   image_double image;
   ntuple_list out = new_ntuple_list(7);
@@ -2419,13 +2645,13 @@ double * LineSegmentDetection( int * n_out,
   image_double scaled_image,angles,modgrad;
   image_char used;
   image_int region = NULL;
-  struct coorlist * list_p;
-  void * mem_p;
+  int * order;
+  int n_order;
   struct rect rec;
   struct point * reg;
-  int reg_size,min_reg_size,i;
+  int reg_size,min_reg_size,i,k,bands;
   unsigned int xsize,ysize;
-  double rho,reg_angle,prec,p,log_nfa,logNT;
+  double rho,prec,p,log_nfa,logNT;
   int ls_count = 0;                   /* line segments are numbered 1,2,3,... */
 
 
@@ -2440,6 +2666,7 @@ double * LineSegmentDetection( int * n_out,
   if( density_th < 0.0 || density_th > 1.0 )
     error("'density_th' value must be in the range [0,1].");
   if( n_bins <= 0 ) error("'n_bins' value must be positive.");
+  if( threads < 1 ) threads = 1;
 
   struct rect *rects = NULL;
   int rects_u = 0;
@@ -2454,14 +2681,14 @@ double * LineSegmentDetection( int * n_out,
   image = new_image_double_ptr( (unsigned int) X, (unsigned int) Y, img );
   if( scale != 1.0 )
     {
-      scaled_image = gaussian_sampler( image, scale, sigma_scale );
-      angles = ll_angle( scaled_image, rho, &list_p, &mem_p,
-                         &modgrad, (unsigned int) n_bins );
+      scaled_image = gaussian_sampler( image, scale, sigma_scale, threads );
+      angles = ll_angle( scaled_image, rho, &order, &n_order,
+                         &modgrad, (unsigned int) n_bins, threads );
       free_image_double(scaled_image);
     }
   else
-    angles = ll_angle( image, rho, &list_p, &mem_p, &modgrad,
-                       (unsigned int) n_bins );
+    angles = ll_angle( image, rho, &order, &n_order, &modgrad,
+                       (unsigned int) n_bins, threads );
   xsize = angles->xsize;
   ysize = angles->ysize;
 
@@ -2488,87 +2715,42 @@ double * LineSegmentDetection( int * n_out,
   if( reg_img != NULL && reg_x != NULL && reg_y != NULL ) /* save region data */
     region = new_image_int_ini(angles->xsize,angles->ysize,0);
   used = new_image_char_ini(xsize,ysize,NOTUSED);
-  reg = (struct point *) calloc( (size_t) (xsize*ysize), sizeof(struct point) );
-  if( reg == NULL ) error("not enough memory!");
-
 
-  /* search for line segments */
-  for(; list_p != NULL; list_p = list_p->next )
-    if( used->data[ list_p->x + list_p->y * used->xsize ] == NOTUSED &&
-        angles->data[ list_p->x + list_p->y * angles->xsize ] != NOTDEF )
-       /* there is no risk of double comparison problems here
-          because we are only interested in the exact NOTDEF value */
-      {
-        /* find the region of connected point and ~equal angle */
-        region_grow( list_p->x, list_p->y, angles, reg, &reg_size,
-                     &reg_angle, used, prec );
+  /* number of bands of rows searched in parallel */
+  bands = threads;
+  if( bands > (int) ysize / BAND_MIN_ROWS ) bands = (int) ysize / BAND_MIN_ROWS;
 
-        /* reject small regions */
-        if( reg_size < min_reg_size ) continue;
-
-        /* construct rectangular approximation for the region */
-        region2rect(reg,reg_size,modgrad,reg_angle,prec,p,&rec);
-
-        /* Check if the rectangle exceeds the minimal density of
-           region points. If not, try to improve the region.
-           The rectangle will be rejected if the final one does
-           not fulfill the minimal density condition.
-           This is an addition to the original LSD algorithm published in
-           "LSD: A Fast Line Segment Detector with a False Detection Control"
-           by R. Grompone von Gioi, J. Jakubowicz, J.M. Morel, and G. Randall.
-           The original algorithm is obtained with density_th = 0.0.
-         */
-        if( !refine( reg, &reg_size, modgrad, reg_angle,
-                     prec, p, &rec, used, angles, density_th ) ) continue;
-
-        /* compute NFA value */
-        log_nfa = rect_improve(&rec,angles,logNT,log_eps);
-        if( log_nfa <= log_eps ) continue;
-
-        /* A New Line Segment was found! */
-        ++ls_count;  /* increase line segment counter */
-
-        /*
-           The gradient was computed with a 2x2 mask, its value corresponds to
-           points with an offset of (0.5,0.5), that should be added to output.
-           The coordinates origin is at the center of pixel (0,0).
-         */
-        rec.x1 += 0.5; rec.y1 += 0.5;
-        rec.x2 += 0.5; rec.y2 += 0.5;
-
-        rec.length = sqrt((rec.x1 - rec.x2) * (rec.x1 - rec.x2) + (rec.y1 - rec.y2) * (rec.y1 - rec.y2));
-        rec.x1 = (int) rec.x1;
-        rec.y1 = (int) rec.y1;
-        rec.x2 = (int) rec.x2;
-        rec.y2 = (int) rec.y2;
-        //printf("length: %lf\n", rec.length);
-        if (rects_a <= rects_u) {
-            if (!rects_a) {
-                rects_a = 32;
-            }
-            rects_a *= 2;
-            rects = realloc(rects, rects_a * sizeof(rects[0]));
-        }
-        rects[rects_u++] = rec;
+  if( bands > 1 )
+    band_segment_detection( bands, order, n_order, angles, modgrad, used, region,
+                            out, &rects, &rects_u, &rects_a, min_reg_size,
+                            prec, p, logNT, log_eps, density_th, scale );
+  else
+    {
+      reg = (struct point *) calloc( (size_t) (xsize*ysize),
+                                     sizeof(struct point) );
+      if( reg == NULL ) error("not enough memory!");
 
-        /* scale the result values if a subsampling was performed */
-        if( scale != 1.0 )
+      /* search for line segments */
+      for(i=0; i<n_order; i++)
+        if( used->data[ order[i] ] == NOTUSED )
           {
-            rec.x1 /= scale; rec.y1 /= scale;
-            rec.x2 /= scale; rec.y2 /= scale;
-            rec.width /= scale;
-            //rec.length /= scale;
+            if( !seed_segment( order[i] % (int) xsize, order[i] / (int) xsize,
+                               angles, modgrad, used, reg, &reg_size,
+                               min_reg_size, prec, p, logNT, log_eps,
+                               density_th, &rec, &log_nfa ) )
+              continue;
+
+            /* A New Line Segment was found! */
+            ++ls_count;  /* increase line segment counter */
+            add_segment( out, &rects, &rects_u, &rects_a, rec, log_nfa, scale );
+
+            /* add region number to 'region' image if needed */
+            if( region != NULL )
+              for(k=0; k<reg_size; k++)
+                region->data[ reg[k].x + reg[k].y * region->xsize ] = ls_count;
           }
-
-        /* add line segment found to output */
-        add_7tuple( out, rec.x1, rec.y1, rec.x2, rec.y2,
-                         rec.width, rec.p, log_nfa );
-
-        /* add region number to 'region' image if needed */
-        if( region != NULL )
-          for(i=0; i<reg_size; i++)
-            region->data[ reg[i].x + reg[i].y * region->xsize ] = ls_count;
-      }
+      free( (void *) reg );
+    }
 
 
   if (need_to_union) {
@@ -2589,8 +2771,7 @@ double * LineSegmentDetection( int * n_out,
   free_image_double(angles);
   free_image_double(modgrad);
   free_image_char(used);
-  free( (void *) reg );
-  free( (void *) mem_p );
+  free( (void *) order );
 
   /* return the result */
   if( reg_img != NULL && reg_x != NULL && reg_y != NULL )
@@ -2652,7 +2833,7 @@ double * lsd_scale_region( int * n_out,
                                ang_th, log_eps, density_th, union_ang_th,
                                union_use_NFA, union_log_eps, n_bins,
                                need_to_union, reg_img, reg_x, reg_y,
-                               length_threshold, dist_threshold );
+                               length_threshold, dist_threshold, 1 );
 }
 
 /*----------------------------------------------------------------------------*/
@@ -112,6 +112,15 @@
                        'reg_img' image, when asked for.
                        Suggested value: NULL
 
+    @param threads     Number of threads. With more than one thread, the
+                       image is split in as many horizontal bands of rows,
+                       searched in parallel, and the segments found twice
+                       near the borders of the bands are dropped. The
+                       result can then differ slightly from the one of a
+                       single thread. The Gaussian sub-sampling and the
+                       gradient are computed with as many threads.
+                       Suggested value: 1
+
     @return            A double array of size 7 x n_out, containing the list
                        of line segments detected. The array contains first
                        7 values of line segment number 1, then the 7 values
@@ -134,7 +143,8 @@ double * LineSegmentDetection( int * n_out,
                                double union_ang_th, int union_use_NFA, double union_log_eps,
                                int n_bins, int need_to_union,
                                int ** reg_img, int * reg_x, int * reg_y,
-                               double length_threshold, double dist_threshold );
+                               double length_threshold, double dist_threshold,
+                               int threads );
 
 /*----------------------------------------------------------------------------*/
 /** LSD Simple Interface with Scale and Region output.
@@ -0,0 +1,21 @@
+#ifndef R_API_H
+#define R_API_H
+
+#include <R.h>
+#include <Rinternals.h>
+
+/*
+ * Pixels handed over from R: either decoded from a file or an encoded raw vector,
+ * or a raw bitmap array with dim c(channels, width, height) as returned by
+ * magick::image_data, which is used in place without a copy.
+ */
+typedef struct {
+    unsigned char *data;
+    int w, h, c;
+    int owned;
+} darknet_pixels;
+
+darknet_pixels darknet_read_pixels(SEXP image);
+void darknet_free_pixels(darknet_pixels p);
+
+#endif
@@ -1,4 +1,5 @@
 #include "network.h"
+#include "network_cache.h"
 #include "utils.h"
 #include "parser.h"
 #include "option_list.h"
@@ -12,6 +13,7 @@
 #include <R.h>
 #include <Rinternals.h>
 #include <Rdefines.h>
+#include "__R_API.h"
 
 #ifdef OPENCV
 #include "opencv2/highgui/highgui_c.h"
@@ -19,14 +21,9 @@ image get_image_from_stream(CvCapture *cap);
 #endif
 
 
-void darknet_predict_classifier(char *datacfg, char *cfgfile, char *weightfile, char *filename, int top,
+void darknet_predict_classifier(network_cache *cache, darknet_pixels pixels, int top,
                                 char **pred_lab, double *pred_score, char **names, int resize){
   
-  network net = parse_network_cfg(cfgfile);
-  if(weightfile){
-    load_weights(&net, weightfile);
-  }
-  set_batch_network(&net, 1);
   srand(2222222);
   /*
   list *options = read_data_cfg(datacfg);
@@ -39,23 +36,30 @@ void darknet_predict_classifier(char *datacfg, char *cfgfile, char *weightfile,
   //char **names = get_labels(name_list);
   clock_t time;
   int *indexes = calloc(top, sizeof(int));
-  char buff[256];
-  char *input = buff;
-  int size = net.w;
+  int size = cache->w;
   while(1){
-    strncpy(input, filename, 256);
-    image im = load_image_color(input, 0, 0);
-    image r = resize_min(im, size);
+    int w = pixels.w;
+    int h = pixels.h;
+    if(w < h){
+      h = (h * size) / w;
+      w = size;
+    } else {
+      w = (w * size) / h;
+      h = size;
+    }
+    network *net = &cache->base;
     if(resize > 0) {
-      resize_network(&net, r.w, r.h);
+      bucket_shape(cache, w, h, &w, &h);
+      net = get_cached_network(cache, w, h);
     }
+    image r = resize_bytes(pixels.data, pixels.w, pixels.h, pixels.c, w, h);
     //printf("%d %d\n", r.w, r.h);
     
     float *X = r.data;
     time=clock();
-    float *predictions = network_predict(net, X);
-    if(net.hierarchy) hierarchy_predictions(predictions, net.outputs, net.hierarchy, 0);
-    top_k(predictions, net.outputs, top, indexes);
+    float *predictions = network_predict(*net, X);
+    if(net->hierarchy) hierarchy_predictions(predictions, net->outputs, net->hierarchy, 0);
+    top_k(predictions, net->outputs, top, indexes);
     //printf("%s: Predicted in %f seconds.\n", input, sec(clock()-time));
     for(i = 0; i < top; ++i){
       int index = indexes[i];
@@ -64,18 +68,38 @@ void darknet_predict_classifier(char *datacfg, char *cfgfile, char *weightfile,
       pred_lab[i] = names[index];
       pred_score[i] = predictions[index];
     }
-    if(r.data != im.data) free_image(r);
-    free_image(im);
-    if (filename) break;
+    free_image(r);
+    break;
   }
+  free(indexes);
 }
 
+static void darknet_free_classifier(SEXP handle){
+  network_cache *cache = R_ExternalPtrAddr(handle);
+  if(!cache) return;
+  free_network_cache(cache);
+  R_ClearExternalPtr(handle);
+}
 
-SEXP darknet_predict(SEXP datasetup, SEXP modelsetup, SEXP modelweights, SEXP image, SEXP first, SEXP labels, SEXP resize){
-  const char *datacfg = CHAR(STRING_ELT(datasetup, 0));
+SEXP darknet_load_classifier(SEXP modelsetup, SEXP modelweights, SEXP cache_size, SEXP bucket, SEXP fp16, SEXP threads){
   const char *cfgfile = CHAR(STRING_ELT(modelsetup, 0));
   const char *weightfile = CHAR(STRING_ELT(modelweights, 0));
-  const char *filename = CHAR(STRING_ELT(image, 0));
+  network_cache *cache = make_network_cache((char *)cfgfile, (char *)weightfile, INTEGER(cache_size)[0], INTEGER(bucket)[0]);
+  if(LOGICAL(fp16)[0]) half_network_weights(&cache->base);
+  set_network_threads(&cache->base, INTEGER(threads)[0]);
+  SEXP handle = PROTECT(R_MakeExternalPtr(cache, R_NilValue, R_NilValue));
+  R_RegisterCFinalizerEx(handle, darknet_free_classifier, TRUE);
+  UNPROTECT(1);
+  return(handle);
+}
+
+SEXP darknet_handle_valid(SEXP handle){
+  return(ScalarLogical(TYPEOF(handle) == EXTPTRSXP && R_ExternalPtrAddr(handle) != NULL));
+}
+
+SEXP darknet_predict(SEXP handle, SEXP image, SEXP first, SEXP labels, SEXP resize){
+  network_cache *cache = R_ExternalPtrAddr(handle);
+  if(!cache) Rf_error("the darknet model is no longer loaded, recreate it with image_darknet_model");
   int top = INTEGER(first)[0];
   int resizing = INTEGER(resize)[0];
   char* pred_lab[top];
@@ -88,8 +112,9 @@ SEXP darknet_predict(SEXP datasetup, SEXP modelsetup, SEXP modelweights, SEXP im
     output_labels[i] = (char *)CHAR(STRING_ELT(labels, i));
   }
 
-  darknet_predict_classifier((char *)datacfg, (char *)cfgfile, (char *)weightfile, (char *)filename, 
-                             top, pred_lab, pred_score, output_labels, resizing);
+  darknet_pixels pixels = darknet_read_pixels(image);
+  darknet_predict_classifier(cache, pixels, top, pred_lab, pred_score, output_labels, resizing);
+  darknet_free_pixels(pixels);
   
   SEXP pred_labels = PROTECT(allocVector(STRSXP, top));
   SEXP pred_scores = PROTECT(allocVector(REALSXP, top));
@@ -102,4 +127,4 @@ SEXP darknet_predict(SEXP datasetup, SEXP modelsetup, SEXP modelweights, SEXP im
   }
   UNPROTECT(4);
   return(result);
-}
\ No newline at end of file
+}
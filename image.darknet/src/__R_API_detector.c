@@ -1,4 +1,5 @@
 #include "network.h"
+#include "memory_planner.h"
 #include "region_layer.h"
 #include "cost_layer.h"
 #include "utils.h"
@@ -6,10 +7,12 @@
 #include "box.h"
 #include "demo.h"
 #include "option_list.h"
+#include "tiled_detector.h"
 
 #include <R.h>
 #include <Rinternals.h>
 #include <Rdefines.h>
+#include "__R_API.h"
 
 
 image **load_alphabet_pkg(char *path)
@@ -29,25 +32,25 @@ image **load_alphabet_pkg(char *path)
 }
 
 
-int darknet_test_detector(char *cfgfile, char *weightfile, char *filename, float thresh, float hier_thresh, char **names, char *path)
+int darknet_test_detector(char *cfgfile, char *weightfile, darknet_pixels pixels, float thresh, float hier_thresh, char **names, char *path, int half, int threads)
 {
   image **alphabet = load_alphabet_pkg(path);
   network net = parse_network_cfg(cfgfile);
   if(weightfile){
     load_weights(&net, weightfile);
   }
+  if(half) half_network_weights(&net);
   set_batch_network(&net, 1);
+  set_network_threads(&net, threads);
+  plan_network_memory(&net);
   srand(2222222);
   clock_t time;
-  char buff[256];
-  char *input = buff;
   int j;
   float nms=.4;
   int boxes_abovethreshold = 0;
   while(1){
-    strncpy(input, filename, 256);
-    image im = load_image_color(input,0,0);
-    image sized = resize_image(im, net.w, net.h);
+    image im = bytes_to_image(pixels.data, pixels.w, pixels.h, pixels.c);
+    image sized = resize_bytes(pixels.data, pixels.w, pixels.h, pixels.c, net.w, net.h);
     layer l = net.layers[net.n-1];
     
     box *boxes = calloc(l.w*l.h*l.n, sizeof(box));
@@ -57,7 +60,7 @@ int darknet_test_detector(char *cfgfile, char *weightfile, char *filename, float
     float *X = sized.data;
     time=clock();
     network_predict(net, X);
-    printf("%s: Predicted in %f seconds.\n", input, sec(clock()-time));
+    printf("Predicted in %f seconds.\n", sec(clock()-time));
     get_region_boxes(l, 1, 1, thresh, probs, boxes, 0, 0, hier_thresh);
     if (l.softmax_tree && nms) do_nms_obj(boxes, probs, l.w*l.h*l.n, l.classes, nms);
     else if (nms) do_nms_sort(boxes, probs, l.w*l.h*l.n, l.classes, nms);
@@ -78,15 +81,14 @@ int darknet_test_detector(char *cfgfile, char *weightfile, char *filename, float
     free_image(sized);
     free(boxes);
     free_ptrs((void **)probs, l.w*l.h*l.n);
-    if (filename) break;
+    break;
   }
   return(boxes_abovethreshold);
 }
 
-SEXP darknet_detect(SEXP modelsetup, SEXP modelweights, SEXP image, SEXP th, SEXP hier_th, SEXP labels, SEXP darknet_root){
+SEXP darknet_detect(SEXP modelsetup, SEXP modelweights, SEXP image, SEXP th, SEXP hier_th, SEXP labels, SEXP darknet_root, SEXP fp16, SEXP threads){
   const char *cfgfile = CHAR(STRING_ELT(modelsetup, 0));
   const char *weightfile = CHAR(STRING_ELT(modelweights, 0));
-  const char *filename = CHAR(STRING_ELT(image, 0));
   float thresh = REAL(th)[0];
   float hier_thresh = REAL(hier_th)[0];
   const char *path = CHAR(STRING_ELT(darknet_root, 0));
@@ -98,13 +100,67 @@ SEXP darknet_detect(SEXP modelsetup, SEXP modelweights, SEXP image, SEXP th, SEX
     output_labels[i] = (char *)CHAR(STRING_ELT(labels, i));
   }
   
+  darknet_pixels pixels = darknet_read_pixels(image);
   int objects_found = darknet_test_detector( 
                         (char *)cfgfile, 
                         (char *)weightfile, 
-                        (char *)filename, 
+                        pixels, 
                         thresh, hier_thresh,
                         output_labels,
-                        (char *)path);
+                        (char *)path,
+                        LOGICAL(fp16)[0],
+                        INTEGER(threads)[0]);
+  darknet_free_pixels(pixels);
   UNPROTECT(1);
   return(modelsetup);
-}
\ No newline at end of file
+}
+
+SEXP darknet_detect_tiled(SEXP modelsetup, SEXP modelweights, SEXP image, SEXP th, SEXP hier_th, SEXP labels, SEXP tile_overlap, SEXP batch, SEXP fp16, SEXP threads){
+  const char *cfgfile = CHAR(STRING_ELT(modelsetup, 0));
+  const char *weightfile = CHAR(STRING_ELT(modelweights, 0));
+  float thresh = REAL(th)[0];
+  float hier_thresh = REAL(hier_th)[0];
+  float overlap = REAL(tile_overlap)[0];
+  int i;
+
+  PROTECT(labels = AS_CHARACTER(labels));
+  darknet_pixels pixels = darknet_read_pixels(image);
+  network net = parse_network_cfg((char *)cfgfile);
+  load_weights(&net, (char *)weightfile);
+  if(LOGICAL(fp16)[0]) half_network_weights(&net);
+  set_batch_network(&net, INTEGER(batch)[0]);
+  set_network_threads(&net, INTEGER(threads)[0]);
+  plan_network_memory(&net);
+  tiled_detections d = detect_tiles(&net, pixels.data, pixels.w, pixels.h, pixels.c, overlap, thresh, hier_thresh, .4);
+  free_network(net);
+  darknet_free_pixels(pixels);
+
+  int found = 0;
+  for(i = 0; i < d.n; ++i){
+    int class = max_index(d.probs[i], d.classes);
+    if(d.probs[i][class] > thresh) ++found;
+  }
+  SEXP label = PROTECT(allocVector(STRSXP, found));
+  SEXP probability = PROTECT(allocVector(REALSXP, found));
+  SEXP boxes = PROTECT(allocMatrix(REALSXP, found, 4));
+  int k = 0;
+  for(i = 0; i < d.n; ++i){
+    int class = max_index(d.probs[i], d.classes);
+    if(d.probs[i][class] <= thresh) continue;
+    SET_STRING_ELT(label, k, STRING_ELT(labels, class));
+    REAL(probability)[k] = d.probs[i][class];
+    REAL(boxes)[k] = d.boxes[i].x;
+    REAL(boxes)[k + found] = d.boxes[i].y;
+    REAL(boxes)[k + 2*found] = d.boxes[i].w;
+    REAL(boxes)[k + 3*found] = d.boxes[i].h;
+    ++k;
+  }
+  SEXP result = PROTECT(allocVector(VECSXP, 4));
+  SET_VECTOR_ELT(result, 0, label);
+  SET_VECTOR_ELT(result, 1, probability);
+  SET_VECTOR_ELT(result, 2, boxes);
+  SET_VECTOR_ELT(result, 3, ScalarInteger(d.tiles));
+  free_tiled_detections(d);
+  UNPROTECT(5);
+  return(result);
+}
@@ -0,0 +1,37 @@
+#include "image.h"
+#include "__R_API.h"
+
+darknet_pixels darknet_read_pixels(SEXP image)
+{
+  darknet_pixels p = {0};
+  if(TYPEOF(image) == STRSXP){
+    const char *filename = CHAR(STRING_ELT(image, 0));
+    p.data = load_image_bytes((char *)filename, &p.w, &p.h, 3);
+    p.c = 3;
+    p.owned = 1;
+    if(!p.data) Rf_error("Cannot load image %s: %s", filename, image_bytes_failure_reason());
+  }else if(TYPEOF(image) == RAWSXP){
+    SEXP dim = Rf_getAttrib(image, R_DimSymbol);
+    if(Rf_length(dim) == 3){
+      p.c = INTEGER(dim)[0];
+      p.w = INTEGER(dim)[1];
+      p.h = INTEGER(dim)[2];
+      p.data = RAW(image);
+      p.owned = 0;
+      if(p.c != 3) Rf_error("image bitmap should have 3 channels, got %d", p.c);
+    }else{
+      p.data = decode_image_bytes(RAW(image), LENGTH(image), &p.w, &p.h, 3);
+      p.c = 3;
+      p.owned = 1;
+      if(!p.data) Rf_error("Cannot decode image: %s", image_bytes_failure_reason());
+    }
+  }else{
+    Rf_error("image should be a path, an encoded raw vector or a raw bitmap array");
+  }
+  return p;
+}
+
+void darknet_free_pixels(darknet_pixels p)
+{
+  if(p.owned) free(p.data);
+}
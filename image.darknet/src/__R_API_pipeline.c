@@ -0,0 +1,94 @@
+#include "network.h"
+#include "memory_planner.h"
+#include "parser.h"
+#include "pipeline.h"
+
+#include <R.h>
+#include <Rinternals.h>
+#include <Rdefines.h>
+#include "__R_API.h"
+
+
+SEXP darknet_score(SEXP modelsetup, SEXP modelweights, SEXP files, SEXP classify, SEXP first, SEXP labels, SEXP resize,
+                   SEXP th, SEXP hier_th, SEXP threads, SEXP batch, SEXP fp16, SEXP net_threads){
+  const char *cfgfile = CHAR(STRING_ELT(modelsetup, 0));
+  const char *weightfile = CHAR(STRING_ELT(modelweights, 0));
+  int i, j;
+  int n = LENGTH(files);
+  char* paths[n > 0 ? n : 1];
+  for(i = 0; i < n; i++) {
+    paths[i] = (char *)CHAR(STRING_ELT(files, i));
+  }
+  PROTECT(labels = AS_CHARACTER(labels));
+
+  pipeline_args args = {0};
+  args.paths = paths;
+  args.n = n;
+  args.threads = INTEGER(threads)[0];
+  args.queue = 2 * INTEGER(threads)[0];
+  args.classify = INTEGER(classify)[0];
+  args.top = INTEGER(first)[0];
+  args.resize = INTEGER(resize)[0];
+  args.thresh = REAL(th)[0];
+  args.hier_thresh = REAL(hier_th)[0];
+  args.nms = .4;
+
+  network net = parse_network_cfg((char *)cfgfile);
+  load_weights(&net, (char *)weightfile);
+  if(LOGICAL(fp16)[0]) half_network_weights(&net);
+  /* classification with resizing changes the network shape for every image */
+  set_batch_network(&net, (args.classify && args.resize) ? 1 : INTEGER(batch)[0]);
+  set_network_threads(&net, INTEGER(net_threads)[0]);
+  plan_network_memory(&net);
+  args.net = &net;
+  pipeline_results r = run_scoring_pipeline(args);
+  free_network(net);
+
+  int rows = args.classify ? n*r.top : r.n_detections;
+  SEXP index = PROTECT(allocVector(INTSXP, rows));
+  SEXP label = PROTECT(allocVector(STRSXP, rows));
+  SEXP probability = PROTECT(allocVector(REALSXP, rows));
+  SEXP boxes = PROTECT(allocMatrix(REALSXP, args.classify ? 0 : rows, 4));
+  if(args.classify){
+    for(i = 0; i < n; ++i){
+      for(j = 0; j < r.top; ++j){
+        int k = i*r.top + j;
+        INTEGER(index)[k] = r.status[i] ? i + 1 : NA_INTEGER;
+        SET_STRING_ELT(label, k, r.status[i] ? STRING_ELT(labels, r.indexes[k]) : NA_STRING);
+        REAL(probability)[k] = r.status[i] ? r.probs[k] : NA_REAL;
+      }
+    }
+  }else{
+    for(i = 0; i < rows; ++i){
+      pipeline_detection d = r.detections[i];
+      INTEGER(index)[i] = d.index + 1;
+      SET_STRING_ELT(label, i, STRING_ELT(labels, d.class));
+      REAL(probability)[i] = d.prob;
+      REAL(boxes)[i] = d.b.x;
+      REAL(boxes)[i + rows] = d.b.y;
+      REAL(boxes)[i + 2*rows] = d.b.w;
+      REAL(boxes)[i + 3*rows] = d.b.h;
+    }
+  }
+  SEXP scored = PROTECT(allocVector(LGLSXP, n));
+  for(i = 0; i < n; ++i) LOGICAL(scored)[i] = r.status[i];
+  SEXP items = PROTECT(allocVector(INTSXP, PIPELINE_STAGES));
+  SEXP busy = PROTECT(allocVector(REALSXP, PIPELINE_STAGES));
+  for(i = 0; i < PIPELINE_STAGES; ++i){
+    INTEGER(items)[i] = r.items[i];
+    REAL(busy)[i] = r.busy[i];
+  }
+
+  SEXP result = PROTECT(allocVector(VECSXP, 8));
+  SET_VECTOR_ELT(result, 0, index);
+  SET_VECTOR_ELT(result, 1, label);
+  SET_VECTOR_ELT(result, 2, probability);
+  SET_VECTOR_ELT(result, 3, boxes);
+  SET_VECTOR_ELT(result, 4, scored);
+  SET_VECTOR_ELT(result, 5, items);
+  SET_VECTOR_ELT(result, 6, busy);
+  SET_VECTOR_ELT(result, 7, ScalarReal(r.elapsed));
+  free_pipeline_results(r);
+  UNPROTECT(9);
+  return(result);
+}
@@ -0,0 +1,54 @@
+#include "network.h"
+#include "memory_planner.h"
+#include "parser.h"
+#include "profiler.h"
+
+#include <R.h>
+#include <Rinternals.h>
+#include <Rdefines.h>
+
+
+SEXP darknet_profile(SEXP modelsetup, SEXP modelweights, SEXP nruns, SEXP batch, SEXP threads, SEXP fp16){
+  const char *cfgfile = CHAR(STRING_ELT(modelsetup, 0));
+  const char *weightfile = CHAR(STRING_ELT(modelweights, 0));
+  int i;
+
+  network net = parse_network_cfg((char *)cfgfile);
+  load_weights(&net, (char *)weightfile);
+  if(LOGICAL(fp16)[0]) half_network_weights(&net);
+  set_batch_network(&net, INTEGER(batch)[0]);
+  set_network_threads(&net, INTEGER(threads)[0]);
+  plan_network_memory(&net);
+  srand(2222222);
+  network_profile p = profile_network(&net, INTEGER(nruns)[0]);
+
+  SEXP type = PROTECT(allocVector(STRSXP, p.n));
+  SEXP out_w = PROTECT(allocVector(INTSXP, p.n));
+  SEXP out_h = PROTECT(allocVector(INTSXP, p.n));
+  SEXP out_c = PROTECT(allocVector(INTSXP, p.n));
+  SEXP seconds = PROTECT(allocVector(REALSXP, p.n));
+  SEXP flops = PROTECT(allocVector(REALSXP, p.n));
+  SEXP bytes = PROTECT(allocVector(REALSXP, p.n));
+  for(i = 0; i < p.n; ++i){
+    SET_STRING_ELT(type, i, mkChar(get_layer_string(net.layers[i].type)));
+    INTEGER(out_w)[i] = p.out_w[i];
+    INTEGER(out_h)[i] = p.out_h[i];
+    INTEGER(out_c)[i] = p.out_c[i];
+    REAL(seconds)[i] = p.seconds[i];
+    REAL(flops)[i] = p.flops[i];
+    REAL(bytes)[i] = p.bytes[i];
+  }
+  free_network_profile(p);
+  free_network(net);
+
+  SEXP result = PROTECT(allocVector(VECSXP, 7));
+  SET_VECTOR_ELT(result, 0, type);
+  SET_VECTOR_ELT(result, 1, out_w);
+  SET_VECTOR_ELT(result, 2, out_h);
+  SET_VECTOR_ELT(result, 3, out_c);
+  SET_VECTOR_ELT(result, 4, seconds);
+  SET_VECTOR_ELT(result, 5, flops);
+  SET_VECTOR_ELT(result, 6, bytes);
+  UNPROTECT(8);
+  return(result);
+}
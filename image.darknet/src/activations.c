@@ -4,6 +4,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* below this many elements the OpenMP fork/join costs more than it saves */
+#define ACTIVATION_OMP_MIN 32768
 
 char *get_activation_string(ACTIVATION a)
 {
@@ -92,9 +98,63 @@ float activate(float x, ACTIVATION a)
     return 0;
 }
 
+static void leaky_activate_array(float *x, const int n)
+{
+    int i = 0;
+#ifdef __SSE2__
+    /* the slope is applied in double precision, as in leaky_activate */
+    const __m128d slope = _mm_set1_pd(.1);
+    #pragma omp parallel for if(n > ACTIVATION_OMP_MIN)
+    for(i = 0; i < n/4; ++i){
+        __m128 v = _mm_loadu_ps(x + 4*i);
+        __m128 lo = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(v), slope));
+        __m128 hi = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), slope));
+        _mm_storeu_ps(x + 4*i, _mm_max_ps(v, _mm_movelh_ps(lo, hi)));
+    }
+    i = n - n%4;
+#endif
+    for(; i < n; ++i) x[i] = leaky_activate(x[i]);
+}
+
+static void relu_activate_array(float *x, const int n)
+{
+    int i = 0;
+#ifdef __SSE2__
+    const __m128 zero = _mm_setzero_ps();
+    #pragma omp parallel for if(n > ACTIVATION_OMP_MIN)
+    for(i = 0; i < n/4; ++i){
+        _mm_storeu_ps(x + 4*i, _mm_max_ps(_mm_loadu_ps(x + 4*i), zero));
+    }
+    i = n - n%4;
+#endif
+    for(; i < n; ++i) x[i] = (x[i] > 0) ? x[i] : 0;
+}
+
+static void logistic_activate_array(float *x, const int n)
+{
+    int i;
+    #pragma omp parallel for if(n > ACTIVATION_OMP_MIN/8)
+    for(i = 0; i < n; ++i) x[i] = logistic_activate(x[i]);
+}
+
 void activate_array(float *x, const int n, const ACTIVATION a)
 {
     int i;
+    switch(a){
+        case LINEAR:
+            return;
+        case LEAKY:
+            leaky_activate_array(x, n);
+            return;
+        case RELU:
+            relu_activate_array(x, n);
+            return;
+        case LOGISTIC:
+            logistic_activate_array(x, n);
+            return;
+        default:
+            break;
+    }
     for(i = 0; i < n; ++i){
         x[i] = activate(x[i], a);
     }
@@ -12,16 +12,17 @@ void reorg_cpu(float *x, int w, int h, int c, int batch, int stride, int forward
 
     for(b = 0; b < batch; ++b){
         for(k = 0; k < c; ++k){
+            int c2 = k % out_c;
+            int offset = k / out_c;
+            float *in_plane = (forward ? x : out) + w*h*(k + c*b);
+            float *out_plane = (forward ? out : x) + w*stride*h*stride*(c2 + out_c*b) + offset % stride;
             for(j = 0; j < h; ++j){
-                for(i = 0; i < w; ++i){
-                    int in_index  = i + w*(j + h*(k + c*b));
-                    int c2 = k % out_c;
-                    int offset = k / out_c;
-                    int w2 = i*stride + offset % stride;
-                    int h2 = j*stride + offset / stride;
-                    int out_index = w2 + w*stride*(h2 + h*stride*(c2 + out_c*b));
-                    if(forward) out[out_index] = x[in_index];
-                    else out[in_index] = x[out_index];
+                float *in_row = in_plane + w*j;
+                float *out_row = out_plane + w*stride*(j*stride + offset / stride);
+                if(forward){
+                    for(i = 0; i < w; ++i) out_row[i*stride] = in_row[i];
+                }else{
+                    for(i = 0; i < w; ++i) in_row[i] = out_row[i*stride];
                 }
             }
         }
@@ -114,13 +115,16 @@ void variance_cpu(float *x, float *mean, int batch, int filters, int spatial, fl
 
 void normalize_cpu(float *x, float *mean, float *variance, int batch, int filters, int spatial)
 {
-    int b, f, i;
-    for(b = 0; b < batch; ++b){
-        for(f = 0; f < filters; ++f){
-            for(i = 0; i < spatial; ++i){
-                int index = b*filters*spatial + f*spatial + i;
-                x[index] = (x[index] - mean[f])/(sqrt(variance[f]) + .000001f);
-            }
+    int k;
+    #pragma omp parallel for if(batch*filters*spatial > 32768)
+    for(k = 0; k < batch*filters; ++k){
+        int i;
+        int f = k%filters;
+        float m = mean[f];
+        double denom = sqrt(variance[f]) + .000001f;
+        float *xk = x + k*spatial;
+        for(i = 0; i < spatial; ++i){
+            xk[i] = (xk[i] - m)/denom;
         }
     }
 }
@@ -2,6 +2,9 @@
 #include <stdio.h>
 #include <math.h>
 #include <stdlib.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 box float_to_box(float *f)
 {
@@ -232,76 +235,156 @@ dbox diou(box a, box b)
 
 typedef struct{
     int index;
-    int class;
-    float **probs;
-} sortable_bbox;
+    float prob;
+} nms_candidate;
 
-int nms_comparator(const void *pa, const void *pb)
+/* Boxes taking part in one NMS pass, as structure of arrays in candidate order */
+typedef struct{
+    float *left, *right, *top, *bottom, *area;
+    int *suppressed;
+} nms_boxes;
+
+static int nms_comparator(const void *pa, const void *pb)
 {
-    sortable_bbox a = *(sortable_bbox *)pa;
-    sortable_bbox b = *(sortable_bbox *)pb;
-    float diff = a.probs[a.index][b.class] - b.probs[b.index][b.class];
-    if(diff < 0) return 1;
-    else if(diff > 0) return -1;
-    return 0;
+    nms_candidate a = *(nms_candidate *)pa;
+    nms_candidate b = *(nms_candidate *)pb;
+    if(a.prob < b.prob) return 1;
+    if(a.prob > b.prob) return -1;
+    return a.index - b.index;
 }
 
-void do_nms_obj(box *boxes, float **probs, int total, int classes, float thresh)
+static nms_boxes make_nms_boxes(int total)
 {
-    int i, j, k;
-    sortable_bbox *s = calloc(total, sizeof(sortable_bbox));
+    nms_boxes s;
+    s.left = calloc(total, sizeof(float));
+    s.right = calloc(total, sizeof(float));
+    s.top = calloc(total, sizeof(float));
+    s.bottom = calloc(total, sizeof(float));
+    s.area = calloc(total, sizeof(float));
+    s.suppressed = calloc(total, sizeof(int));
+    return s;
+}
+
+static void free_nms_boxes(nms_boxes s)
+{
+    free(s.left);
+    free(s.right);
+    free(s.top);
+    free(s.bottom);
+    free(s.area);
+    free(s.suppressed);
+}
 
+/* Collects the boxes with a non-zero probability for class k, highest probability first */
+static int nms_candidates(float **probs, int total, int k, nms_candidate *c)
+{
+    int i;
+    int n = 0;
     for(i = 0; i < total; ++i){
-        s[i].index = i;       
-        s[i].class = classes;
-        s[i].probs = probs;
+        if(probs[i][k] == 0) continue;
+        c[n].index = i;
+        c[n].prob = probs[i][k];
+        ++n;
     }
+    qsort(c, n, sizeof(nms_candidate), nms_comparator);
+    return n;
+}
 
-    qsort(s, total, sizeof(sortable_bbox), nms_comparator);
-    for(i = 0; i < total; ++i){
-        if(probs[s[i].index][classes] == 0) continue;
-        box a = boxes[s[i].index];
-        for(j = i+1; j < total; ++j){
-            box b = boxes[s[j].index];
-            if (box_iou(a, b) > thresh){
-                for(k = 0; k < classes+1; ++k){
-                    probs[s[j].index][k] = 0;
-                }
-            }
+/*
+ * Greedy suppression over the sorted candidates: every one of the first
+ * suppressors candidates that is not suppressed itself suppresses the lower
+ * ranked candidates overlapping it by more than thresh.
+ * Computes the same IoU as box_iou, four boxes at a time.
+ */
+static void suppress_overlaps(box *boxes, nms_candidate *c, int n, int suppressors, float thresh, nms_boxes s)
+{
+    int i, j;
+    for(i = 0; i < n; ++i){
+        box b = boxes[c[i].index];
+        s.left[i] = b.x - b.w/2;
+        s.right[i] = b.x + b.w/2;
+        s.top[i] = b.y - b.h/2;
+        s.bottom[i] = b.y + b.h/2;
+        s.area[i] = b.w*b.h;
+        s.suppressed[i] = 0;
+    }
+    for(i = 0; i < suppressors; ++i){
+        if(s.suppressed[i]) continue;
+        j = i+1;
+#ifdef __SSE2__
+        __m128 left = _mm_set1_ps(s.left[i]);
+        __m128 right = _mm_set1_ps(s.right[i]);
+        __m128 top = _mm_set1_ps(s.top[i]);
+        __m128 bottom = _mm_set1_ps(s.bottom[i]);
+        __m128 area = _mm_set1_ps(s.area[i]);
+        __m128 t = _mm_set1_ps(thresh);
+        __m128 zero = _mm_setzero_ps();
+        for(; j + 4 <= n; j += 4){
+            __m128 w = _mm_sub_ps(_mm_min_ps(right, _mm_loadu_ps(s.right + j)), _mm_max_ps(left, _mm_loadu_ps(s.left + j)));
+            __m128 h = _mm_sub_ps(_mm_min_ps(bottom, _mm_loadu_ps(s.bottom + j)), _mm_max_ps(top, _mm_loadu_ps(s.top + j)));
+            __m128 apart = _mm_or_ps(_mm_cmplt_ps(w, zero), _mm_cmplt_ps(h, zero));
+            __m128 inter = _mm_andnot_ps(apart, _mm_mul_ps(w, h));
+            __m128 uni = _mm_sub_ps(_mm_add_ps(area, _mm_loadu_ps(s.area + j)), inter);
+            int mask = _mm_movemask_ps(_mm_cmpgt_ps(_mm_div_ps(inter, uni), t));
+            if(mask & 1) s.suppressed[j] = 1;
+            if(mask & 2) s.suppressed[j+1] = 1;
+            if(mask & 4) s.suppressed[j+2] = 1;
+            if(mask & 8) s.suppressed[j+3] = 1;
+        }
+#endif
+        for(; j < n; ++j){
+            float w = (s.right[i] < s.right[j] ? s.right[i] : s.right[j]) - (s.left[i] > s.left[j] ? s.left[i] : s.left[j]);
+            float h = (s.bottom[i] < s.bottom[j] ? s.bottom[i] : s.bottom[j]) - (s.top[i] > s.top[j] ? s.top[i] : s.top[j]);
+            float inter = (w < 0 || h < 0) ? 0 : w*h;
+            if(inter/(s.area[i] + s.area[j] - inter) > thresh) s.suppressed[j] = 1;
         }
     }
-    free(s);
 }
 
-
-void do_nms_sort(box *boxes, float **probs, int total, int classes, float thresh)
+void do_nms_obj(box *boxes, float **probs, int total, int classes, float thresh)
 {
-    int i, j, k;
-    sortable_bbox *s = calloc(total, sizeof(sortable_bbox));
+    int i, k;
+    nms_candidate *c = calloc(total, sizeof(nms_candidate));
+    nms_boxes s = make_nms_boxes(total);
 
+    int n = nms_candidates(probs, total, classes, c);
+    /* boxes without objectness never suppress others but their class probabilities can still be cleared */
+    int m = n;
     for(i = 0; i < total; ++i){
-        s[i].index = i;       
-        s[i].class = 0;
-        s[i].probs = probs;
+        if(probs[i][classes] != 0) continue;
+        for(k = 0; k < classes && probs[i][k] == 0; ++k);
+        if(k == classes) continue;
+        c[m].index = i;
+        c[m].prob = 0;
+        ++m;
+    }
+    suppress_overlaps(boxes, c, m, n, thresh, s);
+    for(i = 0; i < m; ++i){
+        if(!s.suppressed[i]) continue;
+        for(k = 0; k < classes+1; ++k){
+            probs[c[i].index][k] = 0;
+        }
     }
+    free_nms_boxes(s);
+    free(c);
+}
+
+
+void do_nms_sort(box *boxes, float **probs, int total, int classes, float thresh)
+{
+    int i, k;
+    nms_candidate *c = calloc(total, sizeof(nms_candidate));
+    nms_boxes s = make_nms_boxes(total);
 
     for(k = 0; k < classes; ++k){
-        for(i = 0; i < total; ++i){
-            s[i].class = k;
-        }
-        qsort(s, total, sizeof(sortable_bbox), nms_comparator);
-        for(i = 0; i < total; ++i){
-            if(probs[s[i].index][k] == 0) continue;
-            box a = boxes[s[i].index];
-            for(j = i+1; j < total; ++j){
-                box b = boxes[s[j].index];
-                if (box_iou(a, b) > thresh){
-                    probs[s[j].index][k] = 0;
-                }
-            }
+        int n = nms_candidates(probs, total, k, c);
+        suppress_overlaps(boxes, c, n, n, thresh, s);
+        for(i = 0; i < n; ++i){
+            if(s.suppressed[i]) probs[c[i].index][k] = 0;
         }
     }
-    free(s);
+    free_nms_boxes(s);
+    free(c);
 }
 
 void do_nms(box *boxes, float **probs, int total, int classes, float thresh)
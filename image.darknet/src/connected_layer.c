@@ -129,7 +129,8 @@ void forward_connected_layer(connected_layer l, network_state state)
     float *a = state.input;
     float *b = l.weights;
     float *c = l.output;
-    gemm(0,1,m,n,k,1,a,k,b,k,1,c,n);
+    if(l.weights_half) gemm_nt_half(m,n,k,1,a,k,l.weights_half,k,c,n);
+    else gemm(0,1,m,n,k,1,a,k,b,k,1,c,n);
     if(l.batch_normalize){
         if(state.train){
             mean_cpu(l.output, l.batch, l.outputs, 1, l.mean);
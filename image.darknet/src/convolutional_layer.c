@@ -7,6 +7,12 @@
 #include "gemm.h"
 #include <stdio.h>
 #include <time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #ifdef AI2
 #include "xnor_layer.h"
@@ -390,27 +396,41 @@ void resize_convolutional_layer(convolutional_layer *l, int w, int h)
     l->workspace_size = get_workspace_size(*l);
 }
 
+static void add_constant(float *x, float a, int n)
+{
+    int j = 0;
+#ifdef __SSE2__
+    __m128 va = _mm_set1_ps(a);
+    for(; j + 4 <= n; j += 4) _mm_storeu_ps(x + j, _mm_add_ps(_mm_loadu_ps(x + j), va));
+#endif
+    for(; j < n; ++j) x[j] += a;
+}
+
+static void scale_constant(float *x, float a, int n)
+{
+    int j = 0;
+#ifdef __SSE2__
+    __m128 va = _mm_set1_ps(a);
+    for(; j + 4 <= n; j += 4) _mm_storeu_ps(x + j, _mm_mul_ps(_mm_loadu_ps(x + j), va));
+#endif
+    for(; j < n; ++j) x[j] *= a;
+}
+
 void add_bias(float *output, float *biases, int batch, int n, int size)
 {
-    int i,j,b;
-    for(b = 0; b < batch; ++b){
-        for(i = 0; i < n; ++i){
-            for(j = 0; j < size; ++j){
-                output[(b*n + i)*size + j] += biases[i];
-            }
-        }
+    int i;
+    #pragma omp parallel for if(batch*n*size > 32768)
+    for(i = 0; i < batch*n; ++i){
+        add_constant(output + i*size, biases[i%n], size);
     }
 }
 
 void scale_bias(float *output, float *scales, int batch, int n, int size)
 {
-    int i,j,b;
-    for(b = 0; b < batch; ++b){
-        for(i = 0; i < n; ++i){
-            for(j = 0; j < size; ++j){
-                output[(b*n + i)*size + j] *= scales[i];
-            }
-        }
+    int i;
+    #pragma omp parallel for if(batch*n*size > 32768)
+    for(i = 0; i < batch*n; ++i){
+        scale_constant(output + i*size, scales[i%n], size);
     }
 }
 
@@ -424,6 +444,28 @@ void backward_bias(float *bias_updates, float *delta, int batch, int n, int size
     }
 }
 
+/* Per batch item products below this many multiply-adds are too small to split inside gemm */
+#define CONV_GEMM_OMP_MIN 4194304
+
+/*
+ * Threads used across the items of a batch: all of them when the batch is
+ * large enough to keep every thread busy or when a single item is too small
+ * for gemm to parallelize well, otherwise 1 and gemm parallelizes over the
+ * rows of each item. Limited by the number of workspace slices.
+ */
+static int batch_threads(convolutional_layer l, network_state state, size_t work)
+{
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    if(state.net.workspaces < threads) threads = state.net.workspaces;
+    if(l.batch < threads) threads = l.batch;
+    if(threads < 2) return 1;
+    if(l.batch >= threads || work < CONV_GEMM_OMP_MIN) return threads;
+    return 1;
+}
+
 void forward_convolutional_layer(convolutional_layer l, network_state state)
 {
     int out_h = convolutional_out_height(l);
@@ -445,15 +487,20 @@ void forward_convolutional_layer(convolutional_layer l, network_state state)
 
 
     float *a = l.weights;
-    float *b = state.workspace;
-    float *c = l.output;
+    int threads = batch_threads(l, state, (size_t)m*n*k);
 
+    #pragma omp parallel for num_threads(threads) if(threads > 1)
     for(i = 0; i < l.batch; ++i){
-        im2col_cpu(state.input, l.c, l.h, l.w, 
+        int t = 0;
+#ifdef _OPENMP
+        t = omp_get_thread_num();
+#endif
+        float *b = state.workspace + t*(l.workspace_size/sizeof(float));
+        float *c = l.output + (size_t)i*n*m;
+        im2col_cpu(state.input + (size_t)i*l.c*l.h*l.w, l.c, l.h, l.w, 
                 l.size, l.stride, l.pad, b);
-        gemm(0,0,m,n,k,1,a,k,b,n,1,c,n);
-        c += n*m;
-        state.input += l.c*l.h*l.w;
+        if(l.weights_half) gemm_nn_half(m,n,k,1,l.weights_half,k,b,n,c,n);
+        else gemm(0,0,m,n,k,1,a,k,b,n,1,c,n);
     }
 
     if(l.batch_normalize){
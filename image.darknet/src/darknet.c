@@ -7,6 +7,9 @@
 #include "cuda.h"
 #include "blas.h"
 #include "connected_layer.h"
+#include "convolutional_layer.h"
+#include "maxpool_layer.h"
+#include "activations.h"
 
 #ifdef OPENCV
 #include "opencv2/highgui/highgui_c.h"
@@ -105,6 +108,77 @@ void speed(char *cfgfile, int tics)
     printf("Speed: %f Hz\n", tics/t);
 }
 
+/* Times the per-element CPU kernels against plain scalar loops on a w x h x c feature map */
+void time_cpu_kernels(int w, int h, int c, int tics)
+{
+    int i, j, k;
+    if(tics == 0) tics = 100;
+    int n = w*h*c;
+    float *x = random_matrix(1, n);
+    float *y = calloc(n, sizeof(float));
+    float *biases = random_matrix(1, c);
+    ACTIVATION acts[] = {LEAKY, LOGISTIC, RELU};
+    double start, ref, fast;
+
+    for(k = 0; k < 3; ++k){
+        start = what_time_is_it_now();
+        for(i = 0; i < tics; ++i){
+            for(j = 0; j < n; ++j) y[j] = activate(x[j], acts[k]);
+        }
+        ref = what_time_is_it_now() - start;
+        start = what_time_is_it_now();
+        for(i = 0; i < tics; ++i){
+            copy_cpu(n, x, 1, y, 1);
+            activate_array(y, n, acts[k]);
+        }
+        fast = what_time_is_it_now() - start;
+        printf("activate %-9s %dx%dx%d: %8.3f ms -> %8.3f ms\n", get_activation_string(acts[k]), w, h, c, 1000*ref/tics, 1000*fast/tics);
+    }
+
+    start = what_time_is_it_now();
+    for(i = 0; i < tics; ++i){
+        for(k = 0; k < c; ++k){
+            for(j = 0; j < w*h; ++j) y[k*w*h + j] = x[k*w*h + j] + biases[k];
+        }
+    }
+    ref = what_time_is_it_now() - start;
+    start = what_time_is_it_now();
+    for(i = 0; i < tics; ++i){
+        add_bias(y, biases, 1, c, w*h);
+    }
+    fast = what_time_is_it_now() - start;
+    printf("add_bias           %dx%dx%d: %8.3f ms -> %8.3f ms\n", w, h, c, 1000*ref/tics, 1000*fast/tics);
+
+    maxpool_layer l = make_maxpool_layer(1, h, w, c, 2, 2, 0);
+    network_state state = {0};
+    state.input = x;
+    start = what_time_is_it_now();
+    for(i = 0; i < tics; ++i){
+        for(k = 0; k < c*l.out_h; ++k){
+            float *r0 = x + (k/l.out_h)*w*h + 2*(k%l.out_h)*w;
+            for(j = 0; j < l.out_w; ++j){
+                float m = r0[2*j];
+                if(r0[2*j+1] > m) m = r0[2*j+1];
+                if(r0[w+2*j] > m) m = r0[w+2*j];
+                if(r0[w+2*j+1] > m) m = r0[w+2*j+1];
+                y[k*l.out_w + j] = m;
+            }
+        }
+    }
+    ref = what_time_is_it_now() - start;
+    start = what_time_is_it_now();
+    for(i = 0; i < tics; ++i){
+        forward_maxpool_layer(l, state);
+    }
+    fast = what_time_is_it_now() - start;
+    printf("maxpool 2x2/2      %dx%dx%d: %8.3f ms -> %8.3f ms\n", w, h, c, 1000*ref/tics, 1000*fast/tics);
+
+    free_layer(l);
+    free(biases);
+    free(y);
+    free(x);
+}
+
 void operations(char *cfgfile)
 {
     gpu_index = -1;
@@ -434,6 +508,8 @@ int main(int argc, char **argv)
         operations(argv[2]);
     } else if (0 == strcmp(argv[1], "speed")){
         speed(argv[2], (argc > 3 && argv[3]) ? atoi(argv[3]) : 0);
+    } else if (0 == strcmp(argv[1], "kernels")){
+        time_cpu_kernels(find_int_arg(argc, argv, "-w", 208), find_int_arg(argc, argv, "-h", 208), find_int_arg(argc, argv, "-c", 64), find_int_arg(argc, argv, "-tics", 0));
     } else if (0 == strcmp(argv[1], "oneoff")){
         oneoff(argv[2], argv[3], argv[4]);
     } else if (0 == strcmp(argv[1], "partial")){
@@ -4,6 +4,14 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define F16C_DISPATCH
+#endif
+
+/* Products smaller than this many multiply-adds run on the calling thread */
+#define GEMM_OMP_MIN 262144
 
 void gemm_bin(int M, int N, int K, float ALPHA, 
         char  *A, int lda, 
@@ -77,6 +85,7 @@ void gemm_nn(int M, int N, int K, float ALPHA,
         float *C, int ldc)
 {
     int i,j,k;
+    #pragma omp parallel for private(j,k) if((double)M*N*K > GEMM_OMP_MIN)
     for(i = 0; i < M; ++i){
         for(k = 0; k < K; ++k){
             register float A_PART = ALPHA*A[i*lda+k];
@@ -93,6 +102,7 @@ void gemm_nt(int M, int N, int K, float ALPHA,
         float *C, int ldc)
 {
     int i,j,k;
+    #pragma omp parallel for private(j,k) if((double)M*N*K > GEMM_OMP_MIN)
     for(i = 0; i < M; ++i){
         for(j = 0; j < N; ++j){
             register float sum = 0;
@@ -110,6 +120,7 @@ void gemm_tn(int M, int N, int K, float ALPHA,
         float *C, int ldc)
 {
     int i,j,k;
+    #pragma omp parallel for private(j,k) if((double)M*N*K > GEMM_OMP_MIN)
     for(i = 0; i < M; ++i){
         for(k = 0; k < K; ++k){
             register float A_PART = ALPHA*A[k*lda+i];
@@ -126,6 +137,7 @@ void gemm_tt(int M, int N, int K, float ALPHA,
         float *C, int ldc)
 {
     int i,j,k;
+    #pragma omp parallel for private(j,k) if((double)M*N*K > GEMM_OMP_MIN)
     for(i = 0; i < M; ++i){
         for(j = 0; j < N; ++j){
             register float sum = 0;
@@ -138,6 +150,155 @@ void gemm_tt(int M, int N, int K, float ALPHA,
 }
 
 
+static unsigned short float_to_half(float f)
+{
+    unsigned int x;
+    memcpy(&x, &f, sizeof(float));
+    unsigned short sign = (x >> 16) & 0x8000;
+    int exponent = (int)((x >> 23) & 0xff) - 127 + 15;
+    unsigned int mantissa = x & 0x7fffff;
+    if(((x >> 23) & 0xff) == 0xff) return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+    if(exponent >= 31) return sign | 0x7c00;
+    if(exponent <= 0){
+        if(exponent < -10) return sign;
+        mantissa |= 0x800000;
+        int shift = 14 - exponent;
+        unsigned int h = mantissa >> shift;
+        unsigned int rest = mantissa & ((1u << shift) - 1);
+        unsigned int halfway = 1u << (shift - 1);
+        if(rest > halfway || (rest == halfway && (h & 1))) ++h;
+        return sign | h;
+    }
+    unsigned int h = (exponent << 10) | (mantissa >> 13);
+    unsigned int rest = mantissa & 0x1fff;
+    /* a carry out of the mantissa correctly rounds up into the exponent */
+    if(rest > 0x1000 || (rest == 0x1000 && (h & 1))) ++h;
+    return sign | h;
+}
+
+static float half_to_float(unsigned short h)
+{
+    unsigned int sign = (unsigned int)(h & 0x8000) << 16;
+    unsigned int exponent = (h >> 10) & 0x1f;
+    unsigned int mantissa = h & 0x3ff;
+    unsigned int x;
+    if(exponent == 0){
+        if(mantissa == 0){
+            x = sign;
+        } else {
+            exponent = 127 - 15 + 1;
+            while(!(mantissa & 0x400)){
+                mantissa <<= 1;
+                --exponent;
+            }
+            x = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+        }
+    } else if(exponent == 31){
+        x = sign | 0x7f800000 | (mantissa << 13);
+    } else {
+        x = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+    float f;
+    memcpy(&f, &x, sizeof(float));
+    return f;
+}
+
+void float_to_half_array(float *x, unsigned short *h, size_t n)
+{
+    size_t i;
+    for(i = 0; i < n; ++i) h[i] = float_to_half(x[i]);
+}
+
+#ifdef F16C_DISPATCH
+static int f16c = 0;
+
+__attribute__((target("avx,f16c")))
+static void half_to_float_f16c(unsigned short *h, float *x, int n)
+{
+    int i = 0;
+    for(; i + 8 <= n; i += 8){
+        _mm256_storeu_ps(x + i, _mm256_cvtph_ps(_mm_loadu_si128((__m128i *)(h + i))));
+    }
+    for(; i < n; ++i) x[i] = half_to_float(h[i]);
+}
+#endif
+
+/*
+ * Detects whether the CPU converts half to float in hardware. Called once when
+ * the weights are stored as half precision, before any parallel forward pass
+ * reads the result in half_to_float_array.
+ */
+void init_half_to_float(void)
+{
+#ifdef F16C_DISPATCH
+    f16c = __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+#endif
+}
+
+void half_to_float_array(unsigned short *h, float *x, int n)
+{
+    int i;
+#ifdef F16C_DISPATCH
+    if(f16c){
+        half_to_float_f16c(h, x, n);
+        return;
+    }
+#endif
+    for(i = 0; i < n; ++i) x[i] = half_to_float(h[i]);
+}
+
+/*
+ * C += ALPHA * A * B with A stored as half precision. Every row of A is widened
+ * once into a float buffer, after which the loops are those of gemm_nn.
+ */
+void gemm_nn_half(int M, int N, int K, float ALPHA, 
+        unsigned short *A, int lda, 
+        float *B, int ldb,
+        float *C, int ldc)
+{
+    #pragma omp parallel if((double)M*N*K > GEMM_OMP_MIN)
+    {
+        int i,j,k;
+        float *row = calloc(K, sizeof(float));
+        #pragma omp for
+        for(i = 0; i < M; ++i){
+            half_to_float_array(A + (size_t)i*lda, row, K);
+            for(k = 0; k < K; ++k){
+                register float A_PART = ALPHA*row[k];
+                for(j = 0; j < N; ++j){
+                    C[i*ldc+j] += A_PART*B[k*ldb+j];
+                }
+            }
+        }
+        free(row);
+    }
+}
+
+/* C += ALPHA * A * B' with B stored as half precision, widened one row at a time */
+void gemm_nt_half(int M, int N, int K, float ALPHA, 
+        float *A, int lda, 
+        unsigned short *B, int ldb,
+        float *C, int ldc)
+{
+    #pragma omp parallel if((double)M*N*K > GEMM_OMP_MIN)
+    {
+        int i,j,k;
+        float *row = calloc(K, sizeof(float));
+        #pragma omp for
+        for(j = 0; j < N; ++j){
+            half_to_float_array(B + (size_t)j*ldb, row, K);
+            for(i = 0; i < M; ++i){
+                register float sum = 0;
+                for(k = 0; k < K; ++k){
+                    sum += ALPHA*A[i*lda+k]*row[k];
+                }
+                C[i*ldc+j] += sum;
+            }
+        }
+        free(row);
+    }
+}
+
 void gemm_cpu(int TA, int TB, int M, int N, int K, float ALPHA, 
         float *A, int lda, 
         float *B, int ldb,
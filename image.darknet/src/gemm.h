@@ -1,5 +1,6 @@
 #ifndef GEMM_H
 #define GEMM_H
+#include <stddef.h>
 
 void gemm_bin(int M, int N, int K, float ALPHA, 
         char  *A, int lda, 
@@ -18,6 +19,20 @@ void gemm_cpu(int TA, int TB, int M, int N, int K, float ALPHA,
         float BETA,
         float *C, int ldc);
 
+void float_to_half_array(float *x, unsigned short *h, size_t n);
+void init_half_to_float(void);
+void half_to_float_array(unsigned short *h, float *x, int n);
+
+void gemm_nn_half(int M, int N, int K, float ALPHA, 
+        unsigned short *A, int lda, 
+        float *B, int ldb,
+        float *C, int ldc);
+
+void gemm_nt_half(int M, int N, int K, float ALPHA, 
+        float *A, int lda, 
+        unsigned short *B, int ldb,
+        float *C, int ldc);
+
 #ifdef GPU
 void gemm_ongpu(int TA, int TB, int M, int N, int K, float ALPHA, 
         float *A_gpu, int lda, 
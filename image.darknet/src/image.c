@@ -4,6 +4,9 @@
 #include "cuda.h"
 #include <stdio.h>
 #include <math.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -1161,21 +1164,141 @@ image load_image_stb(char *filename, int channels)
         exit(0);
     }
     if(channels) c = channels;
-    int i,j,k;
+    image im = bytes_to_image(data, w, h, c);
+    free(data);
+    return im;
+}
+
+unsigned char *load_image_bytes(char *filename, int *w, int *h, int channels)
+{
+    int c;
+    return stbi_load(filename, w, h, &c, channels);
+}
+
+unsigned char *decode_image_bytes(unsigned char *buffer, int len, int *w, int *h, int channels)
+{
+    int c;
+    return stbi_load_from_memory(buffer, len, w, h, &c, channels);
+}
+
+const char *image_bytes_failure_reason()
+{
+    return stbi_failure_reason();
+}
+
+static inline float byte_to_float(unsigned char b)
+{
+    return (float)b/255.;
+}
+
+/*
+ * Converts interleaved 8-bit pixels (stb/magick layout, channel fastest) to a planar image in [0, 1].
+ * Source rows are stride pixels apart so that a region of a larger bitmap can be converted in place.
+ */
+static image bytes_to_image_stride(unsigned char *data, int w, int h, int c, int stride)
+{
+    int j;
     image im = make_image(w, h, c);
-    for(k = 0; k < c; ++k){
-        for(j = 0; j < h; ++j){
+    #pragma omp parallel for if(w*h > 65536)
+    for(j = 0; j < h; ++j){
+        int i, k;
+        unsigned char *row = data + (size_t)c*stride*j;
+        for(k = 0; k < c; ++k){
+            float *dst = im.data + w*j + w*h*k;
             for(i = 0; i < w; ++i){
-                int dst_index = i + w*j + w*h*k;
-                int src_index = k + c*i + c*w*j;
-                im.data[dst_index] = (float)data[src_index]/255.;
+                dst[i] = byte_to_float(row[k + c*i]);
             }
         }
     }
-    free(data);
     return im;
 }
 
+/*
+ * Fused bytes_to_image + resize_image: converts interleaved 8-bit pixels and
+ * resizes them bilinearly in a single pass over the output rows, producing the
+ * same values as resize_image(bytes_to_image(...)) without the intermediate images.
+ */
+static image resize_bytes_stride(unsigned char *data, int w, int h, int c, int stride, int out_w, int out_h)
+{
+    int i;
+    if(out_w == w && out_h == h) return bytes_to_image_stride(data, w, h, c, stride);
+    image resized = make_image(out_w, out_h, c);
+    float w_scale = (out_w > 1) ? (float)(w - 1) / (out_w - 1) : 0;
+    float h_scale = (out_h > 1) ? (float)(h - 1) / (out_h - 1) : 0;
+    int interpolated = (w == 1) ? 0 : out_w - 1;
+    int *ix = calloc(out_w, sizeof(int));
+    float *dx = calloc(out_w, sizeof(float));
+    for(i = 0; i < interpolated; ++i){
+        float sx = i*w_scale;
+        ix[i] = (int) sx;
+        dx[i] = sx - ix[i];
+    }
+
+    #pragma omp parallel
+    {
+        int r, k, x;
+        float *row0 = calloc(out_w, sizeof(float));
+        float *row1 = calloc(out_w, sizeof(float));
+        #pragma omp for
+        for(r = 0; r < out_h; ++r){
+            float sy = r*h_scale;
+            int iy = (int) sy;
+            float dy = sy - iy;
+            int blend = !(r == out_h-1 || h == 1);
+            for(k = 0; k < c; ++k){
+                int t;
+                for(t = 0; t < 1 + blend; ++t){
+                    unsigned char *src = data + (size_t)c*stride*(iy + t) + k;
+                    float *row = t ? row1 : row0;
+                    float last = byte_to_float(src[c*(w-1)]);
+                    for(x = 0; x < interpolated; ++x){
+                        const unsigned char *p = src + c*ix[x];
+                        row[x] = (1 - dx[x]) * byte_to_float(p[0]) + dx[x] * byte_to_float(p[c]);
+                    }
+                    for(; x < out_w; ++x) row[x] = last;
+                }
+                float *dst = resized.data + out_w*(r + out_h*k);
+                x = 0;
+#ifdef __SSE2__
+                __m128 a = _mm_set1_ps(1-dy);
+                __m128 b = _mm_set1_ps(dy);
+                for(; x + 4 <= out_w; x += 4){
+                    __m128 v = _mm_mul_ps(a, _mm_loadu_ps(row0 + x));
+                    if(blend) v = _mm_add_ps(v, _mm_mul_ps(b, _mm_loadu_ps(row1 + x)));
+                    _mm_storeu_ps(dst + x, v);
+                }
+#endif
+                for(; x < out_w; ++x){
+                    float val = (1-dy) * row0[x];
+                    if(blend) val += dy * row1[x];
+                    dst[x] = val;
+                }
+            }
+        }
+        free(row0);
+        free(row1);
+    }
+    free(ix);
+    free(dx);
+    return resized;
+}
+
+image bytes_to_image(unsigned char *data, int w, int h, int c)
+{
+    return bytes_to_image_stride(data, w, h, c, w);
+}
+
+image resize_bytes(unsigned char *data, int w, int h, int c, int out_w, int out_h)
+{
+    return resize_bytes_stride(data, w, h, c, w, out_w, out_h);
+}
+
+/* Converts and resizes the crop_w x crop_h region at (dx, dy) of a w pixels wide bitmap */
+image resize_bytes_region(unsigned char *data, int w, int c, int dx, int dy, int crop_w, int crop_h, int out_w, int out_h)
+{
+    return resize_bytes_stride(data + (size_t)c*((size_t)dy*w + dx), crop_w, crop_h, c, w, out_w, out_h);
+}
+
 image load_image(char *filename, int w, int h, int c)
 {
 #ifdef OPENCV
@@ -71,6 +71,12 @@ image float_to_image(int w, int h, int c, float *data);
 image copy_image(image p);
 image load_image(char *filename, int w, int h, int c);
 image load_image_color(char *filename, int w, int h);
+unsigned char *load_image_bytes(char *filename, int *w, int *h, int channels);
+unsigned char *decode_image_bytes(unsigned char *buffer, int len, int *w, int *h, int channels);
+const char *image_bytes_failure_reason();
+image bytes_to_image(unsigned char *data, int w, int h, int c);
+image resize_bytes(unsigned char *data, int w, int h, int c, int out_w, int out_h);
+image resize_bytes_region(unsigned char *data, int w, int c, int dx, int dy, int crop_w, int crop_h, int out_w, int out_h);
 image **load_alphabet();
 
 float get_pixel(image m, int x, int y, int c);
@@ -32,6 +32,7 @@ void free_layer(layer l)
     if(l.scale_updates)      free(l.scale_updates);
     if(l.weights)            free(l.weights);
     if(l.weight_updates)     free(l.weight_updates);
+    if(l.weights_half)       free(l.weights_half);
     if(l.col_image)          free(l.col_image);
     if(l.delta)              free(l.delta);
     if(l.output)             free(l.output);
@@ -148,6 +148,7 @@ struct layer{
 
     float * weights;
     float * weight_updates;
+    unsigned short * weights_half;
 
     float * col_image;
     float * delta;
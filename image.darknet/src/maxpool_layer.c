@@ -1,6 +1,9 @@
 #include "maxpool_layer.h"
 #include "cuda.h"
 #include <stdio.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 image get_maxpool_image(maxpool_layer l)
 {
@@ -76,6 +79,52 @@ void resize_maxpool_layer(maxpool_layer *l, int w, int h)
     #endif
 }
 
+/*
+ * 2x2 stride 2 pooling without padding: every window lies inside the input,
+ * so no bounds checks are needed and four outputs are produced per SSE step.
+ * The argmax indexes are only needed by the backward pass.
+ */
+static void forward_maxpool_layer_2x2(const maxpool_layer l, network_state state)
+{
+    int k;
+    int h = l.out_h;
+    int w = l.out_w;
+
+    #pragma omp parallel for if(l.batch*l.c*h*w > 8192)
+    for(k = 0; k < l.batch*l.c; ++k){
+        int i, j;
+        float *in = state.input + k*l.w*l.h;
+        float *out = l.output + k*w*h;
+        for(i = 0; i < h; ++i){
+            float *r0 = in + (2*i)*l.w;
+            float *r1 = r0 + l.w;
+            float *o = out + i*w;
+            j = 0;
+#ifdef __SSE2__
+            if(!state.train){
+                for(; j + 4 <= w; j += 4){
+                    __m128 a = _mm_max_ps(_mm_loadu_ps(r0 + 2*j), _mm_loadu_ps(r1 + 2*j));
+                    __m128 b = _mm_max_ps(_mm_loadu_ps(r0 + 2*j + 4), _mm_loadu_ps(r1 + 2*j + 4));
+                    __m128 even = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                    __m128 odd  = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                    _mm_storeu_ps(o + j, _mm_max_ps(even, odd));
+                }
+            }
+#endif
+            for(; j < w; ++j){
+                int index = (r0 - state.input) + 2*j;
+                int max_i = index;
+                float max = r0[2*j];
+                if(r0[2*j+1] > max){ max = r0[2*j+1]; max_i = index + 1; }
+                if(r1[2*j] > max){ max = r1[2*j]; max_i = index + l.w; }
+                if(r1[2*j+1] > max){ max = r1[2*j+1]; max_i = index + l.w + 1; }
+                o[j] = max;
+                l.indexes[k*w*h + i*w + j] = max_i;
+            }
+        }
+    }
+}
+
 void forward_maxpool_layer(const maxpool_layer l, network_state state)
 {
     int b,i,j,k,m,n;
@@ -86,6 +135,11 @@ void forward_maxpool_layer(const maxpool_layer l, network_state state)
     int w = l.out_w;
     int c = l.c;
 
+    if(l.size == 2 && l.stride == 2 && l.pad == 0){
+        forward_maxpool_layer_2x2(l, state);
+        return;
+    }
+
     for(b = 0; b < l.batch; ++b){
         for(k = 0; k < c; ++k){
             for(i = 0; i < h; ++i){
@@ -0,0 +1,228 @@
+#include "memory_planner.h"
+#include "cuda.h"
+#include "utils.h"
+#include <stdlib.h>
+
+typedef struct{
+    size_t size;
+    int busy_until;
+} arena;
+
+static int is_plannable(LAYER_TYPE t)
+{
+    switch(t){
+        case CONVOLUTIONAL:
+        case CONNECTED:
+        case LOCAL:
+        case MAXPOOL:
+        case AVGPOOL:
+        case SOFTMAX:
+        case ROUTE:
+        case REORG:
+        case SHORTCUT:
+        case ACTIVE:
+        case NORMALIZATION:
+        case BATCHNORM:
+        case CROP:
+        case REGION:
+        case DETECTION:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int is_recurrent(LAYER_TYPE t)
+{
+    return t == RNN || t == GRU || t == CRNN;
+}
+
+static void extend_lifetime(int *last, int owner, int t)
+{
+    if(last[owner] < t) last[owner] = t;
+}
+
+/*
+ * Moves the group rooted at layer p into the output of route layer r, at the
+ * position p takes in the concatenation, so that the route copy becomes a no-op.
+ */
+static void embed_output(int *root, size_t *offset, int n, int p, int r, size_t off)
+{
+    int i;
+    for(i = 0; i < n; ++i){
+        if(root[i] != p) continue;
+        root[i] = r;
+        offset[i] += off;
+    }
+}
+
+static int network_output_index(network net)
+{
+    int i;
+    for(i = net.n-1; i > 0; --i) if(net.layers[i].type != COST) break;
+    return i;
+}
+
+static void alias_dropout_layers(network *net)
+{
+    int i;
+    for(i = 1; i < net->n; ++i){
+        layer *l = net->layers + i;
+        if(l->type != DROPOUT) continue;
+        l->output = net->layers[i-1].output;
+        l->delta = net->layers[i-1].delta;
+    }
+}
+
+void unplan_network_memory(network *net)
+{
+    int i;
+    if(!net->planned) return;
+    for(i = 0; i < net->n; ++i){
+        if(!net->planned[i]) continue;
+        net->layers[i].output = 0;
+        net->layers[i].delta = 0;
+    }
+    alias_dropout_layers(net);
+    for(i = 0; i < net->n_arenas; ++i){
+        free(net->arenas[i]);
+    }
+    free(net->arenas);
+    free(net->arena_sizes);
+    free(net->planned);
+    net->arenas = 0;
+    net->arena_sizes = 0;
+    net->planned = 0;
+    net->n_arenas = 0;
+}
+
+int plan_network_memory(network *net)
+{
+    int i, j, k;
+#ifdef GPU
+    if(gpu_index >= 0) return 0;
+#endif
+    for(i = 0; i < net->n; ++i){
+        if(is_recurrent(net->layers[i].type)) return 0;
+    }
+    unplan_network_memory(net);
+
+    int n = net->n;
+    int *owner = calloc(n, sizeof(int));
+    int *last = calloc(n, sizeof(int));
+    int *assigned = calloc(n, sizeof(int));
+    int *root = calloc(n, sizeof(int));
+    size_t *offset = calloc(n, sizeof(size_t));
+    int *first = calloc(n, sizeof(int));
+    int *until = calloc(n, sizeof(int));
+    int *order = calloc(n, sizeof(int));
+    for(i = 0; i < n; ++i){
+        owner[i] = (net->layers[i].type == DROPOUT && i > 0) ? owner[i-1] : i;
+        last[i] = i;
+        first[i] = n;
+        until[i] = -1;
+    }
+    for(i = 0; i < n; ++i){
+        layer l = net->layers[i];
+        if(i > 0) extend_lifetime(last, owner[i-1], i);
+        if(l.type == ROUTE){
+            for(j = 0; j < l.n; ++j) extend_lifetime(last, owner[l.input_layers[j]], i);
+        }
+        if(l.type == SHORTCUT){
+            extend_lifetime(last, owner[l.index], i);
+        }
+    }
+    extend_lifetime(last, owner[network_output_index(*net)], n);
+
+    for(i = 0; i < n; ++i){
+        root[i] = i;
+    }
+    for(i = 0; i < n; ++i){
+        layer l = net->layers[i];
+        if(l.type != ROUTE) continue;
+        if(l.batch != 1 && l.n != 1) continue;
+        size_t off = 0;
+        for(j = 0; j < l.n; ++j){
+            int p = l.input_layers[j];
+            layer in = net->layers[p];
+            if(is_plannable(in.type) && owner[p] == p && root[p] == p && p != i
+                    && in.outputs == l.input_sizes[j] && in.outputs*in.batch > 0){
+                embed_output(root, offset, n, p, i, off);
+            }
+            off += l.input_sizes[j];
+        }
+    }
+
+    int n_groups = 0;
+    for(i = 0; i < n; ++i){
+        layer l = net->layers[i];
+        if(!is_plannable(l.type) || owner[i] != i || l.outputs*l.batch == 0) continue;
+        int r = root[i];
+        if(r == i) order[n_groups++] = i;
+        if(first[r] > i) first[r] = i;
+        if(until[r] < last[i]) until[r] = last[i];
+    }
+    for(k = 1; k < n_groups; ++k){
+        int r = order[k];
+        for(j = k; j > 0 && first[order[j-1]] > first[r]; --j) order[j] = order[j-1];
+        order[j] = r;
+    }
+
+    arena *arenas = calloc(n, sizeof(arena));
+    int n_arenas = 0;
+    for(i = 0; i < n; ++i){
+        assigned[i] = -1;
+    }
+    for(k = 0; k < n_groups; ++k){
+        int r = order[k];
+        layer l = net->layers[r];
+        size_t need = (size_t)l.outputs*l.batch;
+        int best = -1;
+        for(j = 0; j < n_arenas; ++j){
+            if(arenas[j].busy_until >= first[r]) continue;
+            if(best < 0){
+                best = j;
+            }else if(arenas[best].size < need){
+                if(arenas[j].size > arenas[best].size) best = j;
+            }else if(arenas[j].size >= need && arenas[j].size < arenas[best].size){
+                best = j;
+            }
+        }
+        if(best < 0) best = n_arenas++;
+        if(arenas[best].size < need) arenas[best].size = need;
+        arenas[best].busy_until = until[r];
+        assigned[r] = best;
+    }
+
+    net->n_arenas = n_arenas;
+    net->arenas = calloc(n_arenas, sizeof(float *));
+    net->arena_sizes = calloc(n_arenas, sizeof(size_t));
+    net->planned = calloc(n, sizeof(int));
+    for(j = 0; j < n_arenas; ++j){
+        net->arena_sizes[j] = arenas[j].size;
+        net->arenas[j] = calloc(arenas[j].size, sizeof(float));
+        if(!net->arenas[j]) malloc_error();
+    }
+    for(i = 0; i < n; ++i){
+        layer *l = net->layers + i;
+        if(!is_plannable(l->type) || owner[i] != i || assigned[root[i]] < 0) continue;
+        free(l->output);
+        free(l->delta);
+        l->output = net->arenas[assigned[root[i]]] + offset[i];
+        l->delta = 0;
+        net->planned[i] = 1;
+    }
+    alias_dropout_layers(net);
+    net->output = get_network_output(*net);
+
+    free(arenas);
+    free(order);
+    free(until);
+    free(first);
+    free(offset);
+    free(root);
+    free(assigned);
+    free(last);
+    free(owner);
+    return 1;
+}
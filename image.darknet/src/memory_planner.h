@@ -0,0 +1,20 @@
+#ifndef MEMORY_PLANNER_H
+#define MEMORY_PLANNER_H
+#include "network.h"
+
+/*
+ * Inference-only activation memory planner.
+ *
+ * plan_network_memory() computes for every layer output the range of layers
+ * that read it (the next layer, route and shortcut layers, the network output)
+ * and assigns outputs whose lifetimes do not overlap to the same shared arena.
+ * Outputs consumed by a route layer are placed directly in their slice of the
+ * route output (batch 1, or single-input routes), which makes the route copy free.
+ * Layer deltas are released as well since no backward pass follows.
+ * After planning only the network output is guaranteed to hold valid data once
+ * forward_network returns.
+ */
+int plan_network_memory(network *net);
+void unplan_network_memory(network *net);
+
+#endif
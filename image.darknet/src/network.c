@@ -6,6 +6,11 @@
 #include "data.h"
 #include "utils.h"
 #include "blas.h"
+#include "memory_planner.h"
+#include "gemm.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "crop_layer.h"
 #include "connected_layer.h"
@@ -146,15 +151,28 @@ void forward_network(network net, network_state state)
 {
     state.workspace = net.workspace;
     int i;
+#ifdef _OPENMP
+    int default_threads = omp_get_max_threads();
+    if(net.threads > 0) omp_set_num_threads(net.threads);
+#endif
     for(i = 0; i < net.n; ++i){
         state.index = i;
         layer l = net.layers[i];
         if(l.delta){
             scal_cpu(l.outputs * l.batch, 0, l.delta, 1);
         }
-        l.forward(l, state);
+        if(net.layer_seconds){
+            double start = what_time_is_it_now();
+            l.forward(l, state);
+            net.layer_seconds[i] += what_time_is_it_now() - start;
+        } else {
+            l.forward(l, state);
+        }
         state.input = l.output;
     }
+#ifdef _OPENMP
+    omp_set_num_threads(default_threads);
+#endif
 }
 
 void update_network(network net)
@@ -317,6 +335,75 @@ void set_batch_network(network *net, int b)
         }
 #endif
     }
+    if(net->planned) plan_network_memory(net);
+}
+
+/*
+ * Stores the weights of convolutional and connected layers as half precision
+ * for inference: the float weights and their updates are released and the
+ * forward pass widens the weights back to float inside gemm.
+ * Returns the number of bytes released.
+ */
+size_t half_network_weights(network *net)
+{
+    size_t saved = 0;
+#ifndef GPU
+    int i;
+    init_half_to_float();
+    for(i = 0; i < net->n; ++i){
+        layer *l = net->layers + i;
+        size_t n;
+        if(l->weights_half || !l->weights) continue;
+        if(l->type == CONVOLUTIONAL && !l->binary && !l->xnor){
+            n = (size_t)l->n*l->c*l->size*l->size;
+        } else if(l->type == CONNECTED){
+            n = (size_t)l->inputs*l->outputs;
+        } else {
+            continue;
+        }
+        l->weights_half = calloc(n, sizeof(unsigned short));
+        if(!l->weights_half) malloc_error();
+        float_to_half_array(l->weights, l->weights_half, n);
+        free(l->weights);
+        l->weights = 0;
+        saved += n*(sizeof(float) - sizeof(unsigned short));
+        if(l->weight_updates){
+            free(l->weight_updates);
+            l->weight_updates = 0;
+            saved += n*sizeof(float);
+        }
+    }
+#endif
+    return saved;
+}
+
+/*
+ * Runs the network with the given number of OpenMP threads, or with the
+ * OpenMP default when threads is 0, and gives every thread its own slice of
+ * the workspace so that convolutional layers can process the items of a
+ * batch concurrently.
+ */
+void set_network_threads(network *net, int threads)
+{
+    int i;
+    size_t workspace_size = 0;
+    int workspaces = threads;
+#ifdef _OPENMP
+    if(workspaces < 1) workspaces = omp_get_max_threads();
+#endif
+    if(workspaces < 1) workspaces = 1;
+    net->threads = threads;
+#ifdef GPU
+    if(gpu_index >= 0) return;
+#endif
+    if(workspaces == net->workspaces) return;
+    for(i = 0; i < net->n; ++i){
+        if(net->layers[i].workspace_size > workspace_size) workspace_size = net->layers[i].workspace_size;
+    }
+    free(net->workspace);
+    net->workspace = workspace_size ? calloc(workspaces, workspace_size) : 0;
+    if(workspace_size && !net->workspace) malloc_error();
+    net->workspaces = workspaces;
 }
 
 int resize_network(network *net, int w, int h)
@@ -328,6 +415,8 @@ int resize_network(network *net, int w, int h)
     }
 #endif
     int i;
+    int planned = net->planned != 0;
+    if(planned) unplan_network_memory(net);
     //if(w == net->w && h == net->h) return 0;
     net->w = w;
     net->h = h;
@@ -376,12 +465,13 @@ int resize_network(network *net, int w, int h)
         net->workspace = cuda_make_array(0, (workspace_size-1)/sizeof(float)+1);
     }else {
         free(net->workspace);
-        net->workspace = calloc(1, workspace_size);
+        net->workspace = calloc(net->workspaces > 1 ? net->workspaces : 1, workspace_size);
     }
 #else
     free(net->workspace);
-    net->workspace = calloc(1, workspace_size);
+    net->workspace = calloc(net->workspaces > 1 ? net->workspaces : 1, workspace_size);
 #endif
+    if(planned) plan_network_memory(net);
     //fprintf(stderr, " Done!\n");
     return 0;
 }
@@ -591,6 +681,7 @@ float network_accuracy_multi(network net, data d, int n)
 void free_network(network net)
 {
     int i;
+    unplan_network_memory(&net);
     for(i = 0; i < net.n; ++i){
         free_layer(net.layers[i]);
     }
@@ -13,6 +13,8 @@ typedef enum {
 
 typedef struct network{
     float *workspace;
+    int workspaces;
+    int threads;
     int n;
     int batch;
     int *seen;
@@ -55,6 +57,13 @@ typedef struct network{
     int gpu_index;
     tree *hierarchy;
 
+    int n_arenas;
+    float **arenas;
+    size_t *arena_sizes;
+    int *planned;
+
+    double *layer_seconds;
+
     #ifdef GPU
     float **input_gpu;
     float **truth_gpu;
@@ -119,6 +128,8 @@ void print_network(network net);
 void visualize_network(network net);
 int resize_network(network *net, int w, int h);
 void set_batch_network(network *net, int b);
+size_t half_network_weights(network *net);
+void set_network_threads(network *net, int threads);
 int get_network_input_size(network net);
 float get_network_cost(network net);
 
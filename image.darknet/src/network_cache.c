@@ -0,0 +1,151 @@
+#include "network_cache.h"
+#include "memory_planner.h"
+#include "parser.h"
+#include "utils.h"
+#include <stdlib.h>
+
+static void share_layer_weights(layer *dst, layer *src)
+{
+    free(dst->weights);
+    free(dst->weights_half);
+    free(dst->biases);
+    free(dst->scales);
+    free(dst->rolling_mean);
+    free(dst->rolling_variance);
+    free(dst->weight_updates);
+    free(dst->bias_updates);
+    free(dst->scale_updates);
+    dst->weights = src->weights;
+    dst->weights_half = src->weights_half;
+    dst->biases = src->biases;
+    dst->scales = src->scales;
+    dst->rolling_mean = src->rolling_mean;
+    dst->rolling_variance = src->rolling_variance;
+    dst->weight_updates = 0;
+    dst->bias_updates = 0;
+    dst->scale_updates = 0;
+    if(dst->type == RNN || dst->type == CRNN){
+        share_layer_weights(dst->input_layer, src->input_layer);
+        share_layer_weights(dst->self_layer, src->self_layer);
+        share_layer_weights(dst->output_layer, src->output_layer);
+    }
+    if(dst->type == GRU){
+        share_layer_weights(dst->input_z_layer, src->input_z_layer);
+        share_layer_weights(dst->state_z_layer, src->state_z_layer);
+        share_layer_weights(dst->input_r_layer, src->input_r_layer);
+        share_layer_weights(dst->state_r_layer, src->state_r_layer);
+        share_layer_weights(dst->input_h_layer, src->input_h_layer);
+        share_layer_weights(dst->state_h_layer, src->state_h_layer);
+    }
+}
+
+/* Detaches the shared weights so that free_network leaves them to the base network */
+static void unshare_layer_weights(layer *l)
+{
+    l->weights = 0;
+    l->weights_half = 0;
+    l->biases = 0;
+    l->scales = 0;
+    l->rolling_mean = 0;
+    l->rolling_variance = 0;
+    if(l->type == RNN || l->type == CRNN){
+        unshare_layer_weights(l->input_layer);
+        unshare_layer_weights(l->self_layer);
+        unshare_layer_weights(l->output_layer);
+    }
+    if(l->type == GRU){
+        unshare_layer_weights(l->input_z_layer);
+        unshare_layer_weights(l->state_z_layer);
+        unshare_layer_weights(l->input_r_layer);
+        unshare_layer_weights(l->state_r_layer);
+        unshare_layer_weights(l->input_h_layer);
+        unshare_layer_weights(l->state_h_layer);
+    }
+}
+
+static void free_instance(network net)
+{
+    int i;
+    for(i = 0; i < net.n; ++i) unshare_layer_weights(net.layers + i);
+    free_network(net);
+}
+
+network_cache *make_network_cache(char *cfgfile, char *weightfile, int size, int bucket)
+{
+    network_cache *c = calloc(1, sizeof(network_cache));
+    c->base = parse_network_cfg(cfgfile);
+    if(weightfile){
+        load_weights(&c->base, weightfile);
+    }
+    set_batch_network(&c->base, 1);
+    plan_network_memory(&c->base);
+    c->w = c->base.w;
+    c->h = c->base.h;
+    c->cfgfile = copy_string(cfgfile);
+    c->size = size;
+    c->bucket = bucket;
+    c->nets = calloc(size, sizeof(network));
+    c->last_used = calloc(size, sizeof(long));
+    return c;
+}
+
+static int round_to_bucket(int x, int bucket)
+{
+    if(bucket <= 1 || x % bucket == 0) return x;
+    int rounded = ((x + bucket/2) / bucket) * bucket;
+    return rounded < bucket ? bucket : rounded;
+}
+
+void bucket_shape(network_cache *c, int w, int h, int *bucket_w, int *bucket_h)
+{
+    *bucket_w = round_to_bucket(w, c->bucket);
+    *bucket_h = round_to_bucket(h, c->bucket);
+}
+
+/* Returns a network with input size w x h, resizing a new instance only when none is cached */
+network *get_cached_network(network_cache *c, int w, int h)
+{
+    int i;
+    if(c->base.w == w && c->base.h == h) return &c->base;
+    ++c->tick;
+    for(i = 0; i < c->n; ++i){
+        if(c->nets[i].w == w && c->nets[i].h == h){
+            c->last_used[i] = c->tick;
+            return c->nets + i;
+        }
+    }
+    if(c->size < 1){
+        resize_network(&c->base, w, h);
+        return &c->base;
+    }
+    int slot = c->n;
+    if(c->n == c->size){
+        slot = 0;
+        for(i = 1; i < c->n; ++i){
+            if(c->last_used[i] < c->last_used[slot]) slot = i;
+        }
+        free_instance(c->nets[slot]);
+    } else {
+        ++c->n;
+    }
+    network net = parse_network_cfg(c->cfgfile);
+    for(i = 0; i < net.n; ++i) share_layer_weights(net.layers + i, c->base.layers + i);
+    set_batch_network(&net, 1);
+    set_network_threads(&net, c->base.threads);
+    resize_network(&net, w, h);
+    plan_network_memory(&net);
+    c->nets[slot] = net;
+    c->last_used[slot] = c->tick;
+    return c->nets + slot;
+}
+
+void free_network_cache(network_cache *c)
+{
+    int i;
+    for(i = 0; i < c->n; ++i) free_instance(c->nets[i]);
+    free_network(c->base);
+    free(c->nets);
+    free(c->last_used);
+    free(c->cfgfile);
+    free(c);
+}
@@ -0,0 +1,30 @@
+#ifndef NETWORK_CACHE_H
+#define NETWORK_CACHE_H
+#include "network.h"
+
+/*
+ * A network loaded once plus a small LRU of instances resized to other input
+ * shapes. Instances share the weights of the base network and only own their
+ * activations, so classifying inputs of varying aspect ratio does not reparse,
+ * reload or reallocate the network for every image.
+ * Input shapes are rounded to a multiple of bucket pixels to bound the number
+ * of distinct instances.
+ */
+typedef struct{
+    network base;
+    int w, h;
+    char *cfgfile;
+    int size;
+    int bucket;
+    int n;
+    network *nets;
+    long *last_used;
+    long tick;
+} network_cache;
+
+network_cache *make_network_cache(char *cfgfile, char *weightfile, int size, int bucket);
+void bucket_shape(network_cache *c, int w, int h, int *bucket_w, int *bucket_h);
+network *get_cached_network(network_cache *c, int w, int h);
+void free_network_cache(network_cache *c);
+
+#endif
@@ -0,0 +1,298 @@
+#include "pipeline.h"
+#include "image.h"
+#include "region_layer.h"
+#include "tree.h"
+#include "utils.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+typedef struct{
+    int index;
+    int w, h;
+    image sized;
+    float *output;
+    int outputs;
+} pipeline_item;
+
+typedef struct{
+    pipeline_item **items;
+    int size;
+    int head;
+    int count;
+    int producers;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+} pipeline_queue;
+
+typedef struct{
+    pipeline_args args;
+    pipeline_results *results;
+    int w, h;
+    layer region;
+    int next;
+    pthread_mutex_t mutex;
+    pipeline_queue decoded;
+    pipeline_queue predicted;
+} pipeline;
+
+static void make_queue(pipeline_queue *q, int size, int producers)
+{
+    q->items = calloc(size, sizeof(pipeline_item *));
+    q->size = size;
+    q->head = 0;
+    q->count = 0;
+    q->producers = producers;
+    pthread_mutex_init(&q->mutex, 0);
+    pthread_cond_init(&q->not_empty, 0);
+    pthread_cond_init(&q->not_full, 0);
+}
+
+static void free_queue(pipeline_queue *q)
+{
+    pthread_cond_destroy(&q->not_full);
+    pthread_cond_destroy(&q->not_empty);
+    pthread_mutex_destroy(&q->mutex);
+    free(q->items);
+}
+
+static void push_queue(pipeline_queue *q, pipeline_item *item)
+{
+    pthread_mutex_lock(&q->mutex);
+    while(q->count == q->size) pthread_cond_wait(&q->not_full, &q->mutex);
+    q->items[(q->head + q->count) % q->size] = item;
+    ++q->count;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->mutex);
+}
+
+/* Blocks until an item is available; returns 0 once all producers are done and the queue is drained */
+static pipeline_item *pop_queue(pipeline_queue *q)
+{
+    pipeline_item *item = 0;
+    pthread_mutex_lock(&q->mutex);
+    while(q->count == 0 && q->producers > 0) pthread_cond_wait(&q->not_empty, &q->mutex);
+    if(q->count > 0){
+        item = q->items[q->head];
+        q->head = (q->head + 1) % q->size;
+        --q->count;
+        pthread_cond_signal(&q->not_full);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return item;
+}
+
+static void close_queue(pipeline_queue *q)
+{
+    pthread_mutex_lock(&q->mutex);
+    --q->producers;
+    pthread_cond_broadcast(&q->not_empty);
+    pthread_mutex_unlock(&q->mutex);
+}
+
+static void add_busy(pipeline *p, int stage, double seconds, int items)
+{
+    pthread_mutex_lock(&p->mutex);
+    p->results->busy[stage] += seconds;
+    p->results->items[stage] += items;
+    pthread_mutex_unlock(&p->mutex);
+}
+
+static void *decode_thread(void *ptr)
+{
+    pipeline *p = ptr;
+#ifdef _OPENMP
+    omp_set_num_threads(1);
+#endif
+    while(1){
+        pthread_mutex_lock(&p->mutex);
+        int i = p->next++;
+        pthread_mutex_unlock(&p->mutex);
+        if(i >= p->args.n) break;
+
+        double start = what_time_is_it_now();
+        int w, h;
+        unsigned char *data = load_image_bytes(p->args.paths[i], &w, &h, 3);
+        /* the image stays unscored, its status is reported to R */
+        if(!data) continue;
+        int out_w = p->w;
+        int out_h = p->h;
+        if(p->args.classify){
+            if(w < h){
+                out_h = (h * p->w) / w;
+                out_w = p->w;
+            } else {
+                out_w = (w * p->w) / h;
+                out_h = p->w;
+            }
+        }
+        pipeline_item *item = calloc(1, sizeof(pipeline_item));
+        item->index = i;
+        item->w = w;
+        item->h = h;
+        item->sized = resize_bytes(data, w, h, 3, out_w, out_h);
+        free(data);
+        add_busy(p, PIPELINE_DECODE, what_time_is_it_now() - start, 1);
+        push_queue(&p->decoded, item);
+    }
+    close_queue(&p->decoded);
+    return 0;
+}
+
+static void add_detection(pipeline_results *r, int *capacity, pipeline_detection d)
+{
+    if(r->n_detections == *capacity){
+        *capacity = *capacity ? 2 * *capacity : 64;
+        r->detections = realloc(r->detections, *capacity * sizeof(pipeline_detection));
+        if(!r->detections) malloc_error();
+    }
+    r->detections[r->n_detections++] = d;
+}
+
+static void *postprocess_thread(void *ptr)
+{
+    pipeline *p = ptr;
+    pipeline_args a = p->args;
+    pipeline_results *r = p->results;
+    layer l = p->region;
+    int total = l.w*l.h*l.n;
+    int capacity = 0;
+    int i, j;
+    box *boxes = 0;
+    float **probs = 0;
+    if(!a.classify){
+        boxes = calloc(total, sizeof(box));
+        probs = calloc(total, sizeof(float *));
+        for(j = 0; j < total; ++j) probs[j] = calloc(l.classes + 1, sizeof(float));
+    }
+    pipeline_item *item;
+    while((item = pop_queue(&p->predicted))){
+        double start = what_time_is_it_now();
+        if(a.classify){
+            if(a.net->hierarchy) hierarchy_predictions(item->output, item->outputs, a.net->hierarchy, 0);
+            top_k(item->output, item->outputs, a.top, r->indexes + item->index*a.top);
+            for(i = 0; i < a.top; ++i){
+                r->probs[item->index*a.top + i] = item->output[r->indexes[item->index*a.top + i]];
+            }
+        } else {
+            l.output = item->output;
+            for(j = 0; j < total; ++j) memset(probs[j], 0, (l.classes + 1)*sizeof(float));
+            get_region_boxes(l, item->w, item->h, a.thresh, probs, boxes, 0, 0, a.hier_thresh);
+            if (l.softmax_tree && a.nms) do_nms_obj(boxes, probs, total, l.classes, a.nms);
+            else if (a.nms) do_nms_sort(boxes, probs, total, l.classes, a.nms);
+            for(j = 0; j < total; ++j){
+                int class = max_index(probs[j], l.classes);
+                if(probs[j][class] <= a.thresh) continue;
+                pipeline_detection d;
+                d.index = item->index;
+                d.class = class;
+                d.prob = probs[j][class];
+                d.b = boxes[j];
+                add_detection(r, &capacity, d);
+            }
+        }
+        r->status[item->index] = 1;
+        free(item->output);
+        free(item);
+        add_busy(p, PIPELINE_POSTPROCESS, what_time_is_it_now() - start, 1);
+    }
+    if(!a.classify){
+        free(boxes);
+        free_ptrs((void **)probs, total);
+    }
+    return 0;
+}
+
+/* Runs the network over batches pulled from the decoded queue, on the calling thread */
+static void predict_stage(pipeline *p)
+{
+    network *net = p->args.net;
+    int batch = net->batch;
+    pipeline_item **items = calloc(batch, sizeof(pipeline_item *));
+    float *X = 0;
+    int i;
+    if(batch > 1) X = calloc(batch*net->inputs, sizeof(float));
+    while(1){
+        int n = 0;
+        while(n < batch && (items[n] = pop_queue(&p->decoded))) ++n;
+        if(n == 0) break;
+
+        double start = what_time_is_it_now();
+        float *input = items[0]->sized.data;
+        if(batch == 1){
+            if(p->args.classify && p->args.resize) resize_network(net, items[0]->sized.w, items[0]->sized.h);
+        } else {
+            for(i = 0; i < n; ++i) memcpy(X + i*net->inputs, items[i]->sized.data, net->inputs*sizeof(float));
+            input = X;
+        }
+        float *out = network_predict(*net, input);
+        int outputs = get_network_output_size(*net);
+        for(i = 0; i < n; ++i){
+            pipeline_item *item = items[i];
+            item->outputs = outputs;
+            item->output = calloc(outputs, sizeof(float));
+            memcpy(item->output, out + i*outputs, outputs*sizeof(float));
+            free_image(item->sized);
+        }
+        add_busy(p, PIPELINE_PREDICT, what_time_is_it_now() - start, n);
+        for(i = 0; i < n; ++i) push_queue(&p->predicted, items[i]);
+    }
+    close_queue(&p->predicted);
+    free(X);
+    free(items);
+}
+
+pipeline_results run_scoring_pipeline(pipeline_args args)
+{
+    int i;
+    pipeline_results r = {0};
+    if(args.threads < 1) args.threads = 1;
+    if(args.queue < args.net->batch) args.queue = args.net->batch;
+    r.n = args.n;
+    r.top = args.classify ? args.top : 0;
+    r.status = calloc(args.n, sizeof(int));
+    if(args.classify){
+        r.indexes = calloc(args.n*args.top, sizeof(int));
+        r.probs = calloc(args.n*args.top, sizeof(float));
+    }
+
+    pipeline p = {0};
+    p.args = args;
+    p.results = &r;
+    p.w = args.net->w;
+    p.h = args.net->h;
+    p.region = args.net->layers[args.net->n-1];
+    pthread_mutex_init(&p.mutex, 0);
+    make_queue(&p.decoded, args.queue, args.threads);
+    make_queue(&p.predicted, args.queue, 1);
+
+    double start = what_time_is_it_now();
+    pthread_t *decoders = calloc(args.threads, sizeof(pthread_t));
+    pthread_t post;
+    for(i = 0; i < args.threads; ++i){
+        if(pthread_create(decoders + i, 0, decode_thread, &p)) error("Thread creation failed");
+    }
+    if(pthread_create(&post, 0, postprocess_thread, &p)) error("Thread creation failed");
+    predict_stage(&p);
+    for(i = 0; i < args.threads; ++i) pthread_join(decoders[i], 0);
+    pthread_join(post, 0);
+    r.elapsed = what_time_is_it_now() - start;
+
+    free(decoders);
+    free_queue(&p.predicted);
+    free_queue(&p.decoded);
+    pthread_mutex_destroy(&p.mutex);
+    return r;
+}
+
+void free_pipeline_results(pipeline_results r)
+{
+    free(r.status);
+    free(r.indexes);
+    free(r.probs);
+    free(r.detections);
+}
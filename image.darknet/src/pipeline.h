@@ -0,0 +1,55 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+#include "network.h"
+#include "box.h"
+
+/*
+ * Three stage scoring pipeline over a list of image files:
+ * decoder threads load and resize images into a bounded queue, the calling
+ * thread runs the network on batches taken from that queue and a postprocessing
+ * thread turns the network outputs into top-k classes or NMS-filtered boxes.
+ */
+
+#define PIPELINE_DECODE 0
+#define PIPELINE_PREDICT 1
+#define PIPELINE_POSTPROCESS 2
+#define PIPELINE_STAGES 3
+
+typedef struct{
+    network *net;
+    char **paths;
+    int n;
+    int threads;
+    int queue;
+    int classify;
+    int top;
+    int resize;
+    float thresh;
+    float hier_thresh;
+    float nms;
+} pipeline_args;
+
+typedef struct{
+    int index;
+    int class;
+    float prob;
+    box b;
+} pipeline_detection;
+
+typedef struct{
+    int n;
+    int top;
+    int *status;
+    int *indexes;
+    float *probs;
+    int n_detections;
+    pipeline_detection *detections;
+    int items[PIPELINE_STAGES];
+    double busy[PIPELINE_STAGES];
+    double elapsed;
+} pipeline_results;
+
+pipeline_results run_scoring_pipeline(pipeline_args args);
+void free_pipeline_results(pipeline_results r);
+
+#endif
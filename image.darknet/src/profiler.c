@@ -0,0 +1,124 @@
+#include "profiler.h"
+#include "utils.h"
+#include <stdlib.h>
+
+static double recurrent_sum(layer l, double (*f)(layer))
+{
+    double sum = 0;
+    if(l.type == RNN || l.type == CRNN){
+        sum = f(*l.input_layer) + f(*l.self_layer) + f(*l.output_layer);
+    }else if(l.type == GRU){
+        sum = f(*l.input_z_layer) + f(*l.state_z_layer) + f(*l.input_r_layer)
+            + f(*l.state_r_layer) + f(*l.input_h_layer) + f(*l.state_h_layer);
+    }
+    return sum * l.steps;
+}
+
+static double layer_weights(layer l)
+{
+    switch(l.type){
+        case CONVOLUTIONAL:
+        case DECONVOLUTIONAL:
+            return (double)l.n*l.c*l.size*l.size + l.n;
+        case CONNECTED:
+            return (double)l.inputs*l.outputs + l.outputs;
+        case LOCAL:
+            return (double)l.out_w*l.out_h*l.size*l.size*l.c*l.n + l.outputs;
+        default:
+            return 0;
+    }
+}
+
+/* Multiply-adds count as two operations, elementwise layers as one per output */
+double layer_flops(layer l)
+{
+    switch(l.type){
+        case CONVOLUTIONAL:
+            return 2.*l.n*l.size*l.size*l.c*l.out_w*l.out_h*l.batch;
+        case DECONVOLUTIONAL:
+            return 2.*l.n*l.size*l.size*l.c*l.w*l.h*l.batch;
+        case CONNECTED:
+            return 2.*l.inputs*l.outputs*l.batch;
+        case LOCAL:
+            return 2.*l.size*l.size*l.c*l.n*l.out_w*l.out_h*l.batch;
+        case MAXPOOL:
+            return (double)l.size*l.size*l.out_w*l.out_h*l.out_c*l.batch;
+        case AVGPOOL:
+            return (double)l.inputs*l.batch;
+        case RNN:
+        case CRNN:
+        case GRU:
+            return recurrent_sum(l, layer_flops);
+        case ROUTE:
+        case REORG:
+        case DROPOUT:
+        case CROP:
+            return 0;
+        default:
+            return (double)l.outputs*l.batch;
+    }
+}
+
+/* Bytes of inputs and weights read and outputs written by one forward pass */
+double layer_bytes(layer l)
+{
+    if(l.type == RNN || l.type == CRNN || l.type == GRU) return recurrent_sum(l, layer_bytes);
+    if(l.type == DROPOUT) return 0;
+    return ((double)l.inputs*l.batch + (double)l.outputs*l.batch + layer_weights(l)) * sizeof(float);
+}
+
+network_profile profile_network(network *net, int runs)
+{
+    int i, j;
+    network_profile p = {0};
+    if(runs < 1) runs = 1;
+    p.n = net->n;
+    p.runs = runs;
+    p.batch = net->batch;
+    p.seconds = calloc(net->n, sizeof(double));
+    p.flops = calloc(net->n, sizeof(double));
+    p.bytes = calloc(net->n, sizeof(double));
+    p.out_w = calloc(net->n, sizeof(int));
+    p.out_h = calloc(net->n, sizeof(int));
+    p.out_c = calloc(net->n, sizeof(int));
+
+    float *X = calloc(net->batch*net->inputs, sizeof(float));
+    for(i = 0; i < net->batch*net->inputs; ++i) X[i] = rand_uniform(0, 1);
+    /* the first run pays for page faults and cold caches */
+    network_predict(*net, X);
+    net->layer_seconds = p.seconds;
+    for(j = 0; j < runs; ++j) network_predict(*net, X);
+    net->layer_seconds = 0;
+    free(X);
+
+    for(i = 0; i < net->n; ++i){
+        layer l = net->layers[i];
+        p.seconds[i] /= runs;
+        p.flops[i] = layer_flops(l);
+        p.bytes[i] = layer_bytes(l);
+        if(l.out_w*l.out_h*l.out_c == l.outputs){
+            p.out_w[i] = l.out_w;
+            p.out_h[i] = l.out_h;
+            p.out_c[i] = l.out_c;
+        }else if(l.w*l.h > 0 && l.outputs % (l.w*l.h) == 0){
+            p.out_w[i] = l.w;
+            p.out_h[i] = l.h;
+            p.out_c[i] = l.outputs / (l.w*l.h);
+        }else{
+            p.out_w[i] = 1;
+            p.out_h[i] = 1;
+            p.out_c[i] = l.outputs;
+        }
+    }
+    return p;
+}
+
+void free_network_profile(network_profile p)
+{
+    free(p.seconds);
+    free(p.flops);
+    free(p.bytes);
+    free(p.out_w);
+    free(p.out_h);
+    free(p.out_c);
+}
@@ -0,0 +1,27 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+#include "network.h"
+
+/*
+ * Per layer profile of forward_network: mean wall time per run, floating point
+ * operations and bytes read and written per run (for the whole batch) and the
+ * output shape of every layer.
+ */
+typedef struct{
+    int n;
+    int runs;
+    int batch;
+    double *seconds;
+    double *flops;
+    double *bytes;
+    int *out_w;
+    int *out_h;
+    int *out_c;
+} network_profile;
+
+double layer_flops(layer l);
+double layer_bytes(layer l);
+network_profile profile_network(network *net, int runs);
+void free_network_profile(network_profile p);
+
+#endif
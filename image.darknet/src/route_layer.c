@@ -78,8 +78,10 @@ void forward_route_layer(const route_layer l, network_state state)
         int index = l.input_layers[i];
         float *input = state.net.layers[index].output;
         int input_size = l.input_sizes[i];
-        for(j = 0; j < l.batch; ++j){
-            copy_cpu(input_size, input + j*input_size, 1, l.output + offset + j*l.outputs, 1);
+        if(input != l.output + offset){
+            for(j = 0; j < l.batch; ++j){
+                copy_cpu(input_size, input + j*input_size, 1, l.output + offset + j*l.outputs, 1);
+            }
         }
         offset += input_size;
     }
@@ -0,0 +1,104 @@
+#include "tiled_detector.h"
+#include "image.h"
+#include "region_layer.h"
+#include "utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Start positions of tiles of size tile covering [0, size), the last one aligned with the border */
+static int tile_offsets(int size, int tile, float overlap, int *offsets)
+{
+    int n = 0;
+    int step = tile * (1 - overlap);
+    if(step < 1) step = 1;
+    if(tile >= size){
+        offsets[0] = 0;
+        return 1;
+    }
+    int x;
+    for(x = 0; x + tile < size; x += step) offsets[n++] = x;
+    offsets[n++] = size - tile;
+    return n;
+}
+
+static void add_tile_box(tiled_detections *d, int *capacity, box b, float *probs)
+{
+    if(d->n == *capacity){
+        *capacity = *capacity ? 2 * *capacity : 256;
+        d->boxes = realloc(d->boxes, *capacity * sizeof(box));
+        d->probs = realloc(d->probs, *capacity * sizeof(float *));
+        if(!d->boxes || !d->probs) malloc_error();
+    }
+    d->boxes[d->n] = b;
+    d->probs[d->n] = calloc(d->classes + 1, sizeof(float));
+    memcpy(d->probs[d->n], probs, (d->classes + 1)*sizeof(float));
+    ++d->n;
+}
+
+tiled_detections detect_tiles(network *net, unsigned char *data, int w, int h, int c, float overlap, float thresh, float hier_thresh, float nms)
+{
+    int i, j, k, b;
+    layer l = net->layers[net->n-1];
+    int total = l.w*l.h*l.n;
+    int tile_w = (w < net->w) ? w : net->w;
+    int tile_h = (h < net->h) ? h : net->h;
+    int *xs = calloc(w, sizeof(int));
+    int *ys = calloc(h, sizeof(int));
+    int nx = tile_offsets(w, tile_w, overlap, xs);
+    int ny = tile_offsets(h, tile_h, overlap, ys);
+
+    tiled_detections d = {0};
+    d.classes = l.classes;
+    d.tiles = nx*ny;
+    int capacity = 0;
+    box *boxes = calloc(total, sizeof(box));
+    float **probs = calloc(total, sizeof(float *));
+    for(j = 0; j < total; ++j) probs[j] = calloc(l.classes + 1, sizeof(float));
+    float *X = calloc(net->batch*net->inputs, sizeof(float));
+
+    for(i = 0; i < d.tiles; i += net->batch){
+        int n = (d.tiles - i < net->batch) ? d.tiles - i : net->batch;
+        for(b = 0; b < n; ++b){
+            int t = i + b;
+            image tile = resize_bytes_region(data, w, c, xs[t % nx], ys[t / nx], tile_w, tile_h, net->w, net->h);
+            memcpy(X + b*net->inputs, tile.data, net->inputs*sizeof(float));
+            free_image(tile);
+        }
+        network_predict(*net, X);
+        l = net->layers[net->n-1];
+        for(b = 0; b < n; ++b){
+            int t = i + b;
+            layer lb = l;
+            lb.output = l.output + b*l.outputs;
+            for(j = 0; j < total; ++j) memset(probs[j], 0, (l.classes + 1)*sizeof(float));
+            get_region_boxes(lb, tile_w, tile_h, thresh, probs, boxes, 0, 0, hier_thresh);
+            if (l.softmax_tree && nms) do_nms_obj(boxes, probs, total, l.classes, nms);
+            else if (nms) do_nms_sort(boxes, probs, total, l.classes, nms);
+            for(j = 0; j < total; ++j){
+                for(k = 0; k < l.classes && probs[j][k] == 0; ++k);
+                if(k == l.classes) continue;
+                box bx = boxes[j];
+                bx.x += xs[t % nx];
+                bx.y += ys[t / nx];
+                add_tile_box(&d, &capacity, bx, probs[j]);
+            }
+        }
+    }
+    if(d.n && nms){
+        if (l.softmax_tree) do_nms_obj(d.boxes, d.probs, d.n, d.classes, nms);
+        else do_nms_sort(d.boxes, d.probs, d.n, d.classes, nms);
+    }
+
+    free(X);
+    free_ptrs((void **)probs, total);
+    free(boxes);
+    free(ys);
+    free(xs);
+    return d;
+}
+
+void free_tiled_detections(tiled_detections d)
+{
+    free_ptrs((void **)d.probs, d.n);
+    free(d.boxes);
+}
@@ -0,0 +1,24 @@
+#ifndef TILED_DETECTOR_H
+#define TILED_DETECTOR_H
+#include "network.h"
+#include "box.h"
+
+/*
+ * Detection on images much larger than the network input: the image is cut
+ * into overlapping tiles of net.w x net.h pixels which are scored net.batch at
+ * a time, after which the boxes of all tiles are mapped to image coordinates
+ * and merged with a second NMS pass across tiles.
+ * Boxes are in pixels of the full image, probs has classes + 1 columns.
+ */
+typedef struct{
+    int n;
+    int classes;
+    int tiles;
+    box *boxes;
+    float **probs;
+} tiled_detections;
+
+tiled_detections detect_tiles(network *net, unsigned char *data, int w, int h, int c, float overlap, float thresh, float hier_thresh, float nms);
+void free_tiled_detections(tiled_detections d);
+
+#endif
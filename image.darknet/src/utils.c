@@ -6,6 +6,7 @@
 #include <unistd.h>
 #include <float.h>
 #include <limits.h>
+#include <sys/time.h>
 
 #include "utils.h"
 
@@ -171,6 +172,15 @@ float sec(clock_t clocks)
     return (float)clocks/CLOCKS_PER_SEC;
 }
 
+double what_time_is_it_now()
+{
+    struct timeval time;
+    if (gettimeofday(&time,NULL)){
+        return 0;
+    }
+    return (double)time.tv_sec + (double)time.tv_usec * .000001;
+}
+
 void top_k(float *a, int n, int k, int *index)
 {
     int i,j;